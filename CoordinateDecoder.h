@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "LayoutProfiles.h"
+
+struct Vec3 {
+    int x, y, z;
+};
+
+// Read-only view over 32-bit pixels. Rows and pixels may be strided, so the
+// same decoder works on a locked GDI+ bitmap, a video frame or a NumPy array.
+struct PixelView {
+    const uint8_t* base = nullptr;
+    ptrdiff_t rowStride = 0;         // bytes between rows
+    ptrdiff_t pixelStride = 4;       // bytes between pixels in a row
+    int width = 0;
+    int height = 0;
+    uint32_t colorMask = 0xFFFFFFFF; // 0x00FFFFFF for sources without alpha (RGB32)
+    int tolerance = 0;               // per channel; lossy video never hits the text colour exactly
+
+    bool matches(int x, int y, uint32_t color) const {
+        return matches(x, y, color, tolerance);
+    }
+
+    bool matches(int x, int y, uint32_t color, int maxDifference) const {
+        uint32_t value;
+        memcpy(&value, base + y * rowStride + x * pixelStride, sizeof(value));
+        if (!maxDifference) return (value & colorMask) == (color & colorMask);
+
+        for (int shift = 0; shift < 32; shift += 8) {
+            if (!((colorMask >> shift) & 0xFF)) continue;
+            int a = (value >> shift) & 0xFF;
+            int b = (color >> shift) & 0xFF;
+            if (abs(a - b) > maxDifference) return false;
+        }
+        return true;
+    }
+};
+
+// The F3 text only ever sits in the top-left corner, so only that part of the
+// frame is scanned.
+inline PixelView CropToSearchRegion(PixelView view) {
+    view.width = (std::max)(view.width / 3, (std::min)(125, view.width));
+    view.height = view.height / 3;
+    return view;
+}
+
+// Reads the player coordinates from the F3 overlay drawn with `Layout`.
+// `view` must already be cropped to the search region. `fields` receives how
+// many of x, y, z were reached, which tells a real match from noise.
+template <class Layout>
+bool DecodeShownCoordinatesAs(const PixelView& view, Vec3* coordinates, int* fields = nullptr) {
+    int searchWidth = view.width;
+    int searchHeight = view.height;
+
+    int startTextX = 0, startTextY = 0, streak = 0;
+
+    for (int y = Layout::firstRow; y < searchHeight; y++) {
+        for (int x = Layout::leftMargin; x < searchWidth; x++) {
+            if (view.matches(x, y, Layout::textColor)) {
+                if (!startTextX) { startTextX = x; startTextY = y; }
+                streak++;
+            }
+            else if (streak < Layout::streakUnit) streak = 0;
+            else if (streak >= Layout::streakUnit) break;
+        }
+        if (streak >= Layout::streakUnit) break;
+    }
+
+    if (streak < Layout::streakUnit) return false;
+
+    const GlyphColumns& glyphs = Layout::Glyphs();
+    int scale = streak / Layout::streakUnit;
+    if (startTextY + (glyphs.rows - 1) * scale >= searchHeight) return false;
+
+    if (Layout::hasBackground) {
+        // The box pads the text, so left of and above the stroke is box, not world
+        int boxX = startTextX - scale, boxY = startTextY - scale;
+        if (boxX < 0 || boxY < 0) return false;
+        if (!view.matches(boxX, startTextY, Layout::backgroundColor, Layout::backgroundTolerance) ||
+            !view.matches(startTextX, boxY, Layout::backgroundColor, Layout::backgroundTolerance)) return false;
+    }
+
+    startTextX += Layout::prefixWidth * scale;
+    int coords[3] = { 0, 0, 0 };
+    int index = 0;
+    bool isSigned = false;
+
+    while (startTextX < searchWidth && index <= 2) {
+        unsigned int columnMask = 0;
+        for (int dy = 0; dy < glyphs.rows; dy++) {
+            columnMask <<= 1;
+            if (view.matches(startTextX, startTextY + dy * scale, Layout::textColor))
+                columnMask |= 1;
+        }
+
+        int digit = -1;
+        for (int d = 0; d < 10; d++) {
+            if (columnMask == glyphs.digits[d]) { digit = d; break; }
+        }
+        if (digit != -1) {
+            coords[index] = coords[index] * 10 + digit;
+        }
+        else if (columnMask == glyphs.minus) {
+            isSigned = true;
+        }
+        else if (columnMask == glyphs.separator) {
+            if (isSigned) coords[index] *= -1;
+            ++index;
+            isSigned = false;
+        }
+        else if (index < 2 && isSigned) {
+            coords[index] *= -1;
+        }
+
+        int advance = digit != -1 && glyphs.digitAdvance[digit] ? glyphs.digitAdvance[digit] : Layout::glyphAdvance;
+        startTextX += advance * scale;
+    }
+
+    if (isSigned && index <= 2) {
+        coords[index] *= -1;
+    }
+
+    coordinates->x = coords[0];
+    coordinates->y = coords[1];
+    coordinates->z = coords[2];
+    if (fields) *fields = (index < 2 ? index : 2) + 1;
+    return true;
+}
+
+using DecodeFn = bool (*)(const PixelView&, Vec3*, int*);
+
+// One specialised decoder per profile, indexed by LayoutId.
+static const DecodeFn kLayoutDecoders[(int)LayoutId::Count] = {
+    &DecodeShownCoordinatesAs<LayoutModern>,
+    &DecodeShownCoordinatesAs<LayoutLegacy>,
+    &DecodeShownCoordinatesAs<LayoutTextBackground>,
+    &DecodeShownCoordinatesAs<LayoutUnicode>,
+};
+
+// TextBackground text also decodes as Modern, so the box is checked first.
+static const LayoutId kDetectionOrder[(int)LayoutId::Count] = {
+    LayoutId::TextBackground,
+    LayoutId::Modern,
+    LayoutId::Legacy,
+    LayoutId::Unicode,
+};
+
+// Tries every profile and returns the first whose decode reaches all three
+// coordinates. Slow path; callers cache the result in a LayoutCache.
+inline bool DetectLayout(const PixelView& view, LayoutId* layout, Vec3* coordinates) {
+    for (LayoutId candidate : kDetectionOrder) {
+        int fields = 0;
+        if (kLayoutDecoders[(int)candidate](view, coordinates, &fields) && fields == 3) {
+            *layout = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Remembers the detected profile per capture target (window, recording,
+// batch), so detection runs once and every later frame goes straight to the
+// specialised decoder. A failed decode with the cached profile triggers one
+// re-detection, which covers switching versions in the same window.
+class LayoutCache {
+public:
+    bool Decode(uintptr_t key, const PixelView& view, Vec3* coordinates) {
+        for (auto& entry : entries) {
+            if (entry.key != key) continue;
+            int fields = 0;
+            if (kLayoutDecoders[(int)entry.layout](view, coordinates, &fields) && fields == 3) return true;
+            return DetectLayout(view, &entry.layout, coordinates);
+        }
+
+        LayoutId layout;
+        if (!DetectLayout(view, &layout, coordinates)) return false;
+        entries.push_back({ key, layout });
+        return true;
+    }
+
+    // Call when the target goes away; window handles get reused.
+    void Forget(uintptr_t key) {
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].key == key) { entries.erase(entries.begin() + i); return; }
+        }
+    }
+
+private:
+    struct Entry {
+        uintptr_t key;
+        LayoutId layout;
+    };
+    std::vector<Entry> entries;   // a handful of windows at most
+};
+
+// Uncached convenience wrapper: detects the layout on every call.
+inline bool DecodeShownCoordinates(const PixelView& view, Vec3* coordinates) {
+    LayoutId layout;
+    return DetectLayout(view, &layout, coordinates);
+}
+
+inline Vec3 CalculateNearest4x4Coordinate(const Vec3& playerPos) {
+    Vec3 nearest;
+
+    auto roundToNearestChunkCoord = [](int coord) -> int {
+        // Calculate which chunk the coordinate is in
+        // Chunks are 16 blocks wide, starting at multiples of 16
+        // The 4x4 center is at chunk_start + 4
+
+        int chunkStart;
+        if (coord >= 0) {
+            chunkStart = (coord / 16) * 16;
+        }
+        else {
+            // For negative coordinates, we need floor division
+            chunkStart = ((coord - 15) / 16) * 16;
+        }
+
+        // Find the nearest 4x4 center (either in this chunk or adjacent chunks)
+        int option1 = chunkStart + 4;      // 4x4 center in current chunk
+        int option2 = chunkStart - 12;     // 4x4 center in previous chunk
+        int option3 = chunkStart + 20;     // 4x4 center in next chunk
+
+        // Return the closest one
+        int dist1 = abs(coord - option1);
+        int dist2 = abs(coord - option2);
+        int dist3 = abs(coord - option3);
+
+        if (dist1 <= dist2 && dist1 <= dist3) return option1;
+        if (dist2 <= dist3) return option2;
+        return option3;
+        };
+
+    nearest.x = roundToNearestChunkCoord(playerPos.x);
+    nearest.y = playerPos.y;
+    nearest.z = roundToNearestChunkCoord(playerPos.z);
+
+    return nearest;
+}
+
+// Horizontal distance, which is what matters when walking to a dig spot.
+inline double HorizontalDistance(const Vec3& a, const Vec3& b) {
+    double dx = a.x - b.x;
+    double dz = a.z - b.z;
+    return sqrt(dx * dx + dz * dz);
+}
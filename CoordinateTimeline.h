@@ -0,0 +1,134 @@
+#pragma once
+
+#include "CoordinateDecoder.h"
+
+#include <cstdint>
+#include <map>
+
+// A recording that can be seeked and decoded one frame at a time.
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    virtual int64_t DurationMs() const = 0;
+    virtual int64_t FrameIntervalMs() const = 0;
+
+    // Seeks to the frame shown at `timeMs` and decodes only that frame.
+    // `view` stays valid until the next call.
+    virtual bool ReadFrameAt(int64_t timeMs, PixelView* view) = 0;
+};
+
+// Sparse, lazily filled index from time to decoded player position. Frames are
+// only decoded when a query needs them and every decoded frame is kept, so
+// follow-up queries over the same recording mostly hit the cache.
+class CoordinateTimeline {
+public:
+    struct Sample {
+        int64_t timeMs;
+        bool found;     // false if the frame had no readable F3 text
+        Vec3 position;
+    };
+
+    // `maxSpeed` (blocks per second) bounds how fast the player can close in
+    // on a target, which lets distance queries skip frames safely. Portals
+    // and ender pearls break this assumption; raise it if that matters.
+    explicit CoordinateTimeline(FrameSource& frameSource, double maxSpeed = 20.0)
+        : source(frameSource), maxSpeed(maxSpeed) {
+        frameMs = source.FrameIntervalMs() > 0 ? source.FrameIntervalMs() : 1;
+    }
+
+    const Sample& SampleAt(int64_t timeMs) {
+        int64_t slot = timeMs / frameMs;
+        auto it = samples.find(slot);
+        if (it != samples.end()) return it->second;
+
+        Sample sample = { slot * frameMs, false, { 0, 0, 0 } };
+        PixelView view;
+        if (source.ReadFrameAt(sample.timeMs, &view)) {
+            sample.found = layouts.Decode(0, CropToSearchRegion(view), &sample.position);
+        }
+        decodedFrames++;
+        return samples.emplace(slot, sample).first->second;
+    }
+
+    // Position shown at `timeMs`. If that frame is unreadable (menus, F3 off,
+    // pause screen) the nearest readable frame within `toleranceMs` is used,
+    // probing outwards at exponentially growing offsets.
+    bool PositionAt(int64_t timeMs, Sample* result, int64_t toleranceMs = 5000) {
+        const Sample& exact = SampleAt(timeMs);
+        if (exact.found) { *result = exact; return true; }
+
+        for (int64_t offset = frameMs; offset <= toleranceMs; offset *= 2) {
+            if (timeMs - offset >= 0) {
+                const Sample& before = SampleAt(timeMs - offset);
+                if (before.found) { *result = before; return true; }
+            }
+            if (timeMs + offset < DurationMs()) {
+                const Sample& after = SampleAt(timeMs + offset);
+                if (after.found) { *result = after; return true; }
+            }
+        }
+        return false;
+    }
+
+    // Finds a time at or after `fromMs` where the player is within `radius`
+    // blocks (horizontally) of `target`, then bisects back to the crossing
+    // frame. From a readable frame it skips as far as the player could not
+    // have reached the radius in, so no visit is missed unless they moved
+    // faster than `maxSpeed`. Across unreadable frames the step grows
+    // exponentially up to `maxStepMs`; a visit hidden entirely inside such a
+    // stretch can be missed.
+    bool FirstWithin(const Vec3& target, double radius, int64_t fromMs, int64_t* hitMs,
+        int64_t maxStepMs = 30000) {
+        int64_t duration = DurationMs();
+        int64_t outside = -1;
+        int64_t blindStep = frameMs;
+
+        for (int64_t t = fromMs; t < duration; ) {
+            const Sample& sample = SampleAt(t);
+            if (sample.found) {
+                double distance = HorizontalDistance(sample.position, target);
+                if (distance <= radius) {
+                    *hitMs = outside < 0 ? sample.timeMs : Bisect(target, radius, outside, sample.timeMs);
+                    return true;
+                }
+                int64_t safeMs = (int64_t)((distance - radius) / maxSpeed * 1000.0);
+                blindStep = frameMs;
+                outside = sample.timeMs;
+                t = sample.timeMs + (std::max)(safeMs, frameMs);
+            }
+            else {
+                outside = sample.timeMs;
+                t = sample.timeMs + blindStep;
+                blindStep = (std::min)(blindStep * 2, maxStepMs);
+            }
+        }
+        return false;
+    }
+
+    int64_t DurationMs() const { return source.DurationMs(); }
+    int64_t TotalFrames() const { return source.DurationMs() / frameMs; }
+    int64_t DecodedFrames() const { return decodedFrames; }
+    const std::map<int64_t, Sample>& Samples() const { return samples; }
+
+private:
+    // Invariant: player is outside the radius at `lo` and inside at `hi`.
+    // Unreadable frames count as outside.
+    int64_t Bisect(const Vec3& target, double radius, int64_t lo, int64_t hi) {
+        while (hi - lo > frameMs) {
+            int64_t mid = lo + (hi - lo) / 2;
+            const Sample& sample = SampleAt(mid);
+            if (sample.timeMs <= lo || sample.timeMs >= hi) break;
+            if (sample.found && HorizontalDistance(sample.position, target) <= radius) hi = sample.timeMs;
+            else lo = sample.timeMs;
+        }
+        return hi;
+    }
+
+    FrameSource& source;
+    double maxSpeed;
+    int64_t frameMs;
+    int64_t decodedFrames = 0;
+    LayoutCache layouts;
+    std::map<int64_t, Sample> samples;   // keyed by frame slot (timeMs / frameMs)
+};
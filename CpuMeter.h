@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// CPU time spent by the calling thread over the last minute. Sample() must
+// be called from the thread being measured, typically once per capture.
+class CpuMeter {
+public:
+    void Sample() {
+        double wallMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        samples.push_back({ wallMs, ThreadCpuMs() });
+        while (samples.size() > 2 && wallMs - samples[1].wallMs >= kWindowMs) samples.pop_front();
+    }
+
+    // Milliseconds of CPU per minute of wall time, extrapolated while less
+    // than a minute of samples exists.
+    double CpuMsPerMinute() const {
+        if (samples.size() < 2) return 0.0;
+        double wall = samples.back().wallMs - samples.front().wallMs;
+        double cpu = samples.back().cpuMs - samples.front().cpuMs;
+        return wall > 0.0 ? cpu / wall * kWindowMs : 0.0;
+    }
+
+    static double ThreadCpuMs() {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return 0.0;
+        ULARGE_INTEGER k, u;
+        k.LowPart = kernel.dwLowDateTime; k.HighPart = kernel.dwHighDateTime;
+        u.LowPart = user.dwLowDateTime; u.HighPart = user.dwHighDateTime;
+        return (k.QuadPart + u.QuadPart) / 10000.0;   // 100 ns units
+#else
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+#endif
+    }
+
+private:
+    static constexpr double kWindowMs = 60000.0;
+
+    struct Point {
+        double wallMs;
+        double cpuMs;
+    };
+    std::deque<Point> samples;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "OverlayRenderer.h"
+
+#include <windows.h>
+
+// GDI surface for the overlay window: a backbuffer that lives as long as the
+// window and a glyph atlas drawn once with a monospaced font. Updates blit
+// atlas cells into the backbuffer; WM_PAINT only copies the invalid part of
+// the backbuffer to the screen.
+class GdiOverlaySurface : public OverlaySurface {
+public:
+    ~GdiOverlaySurface() {
+        Destroy();
+    }
+
+    bool Create(HWND hwnd) {
+        Destroy();
+
+        RECT clientRect;
+        GetClientRect(hwnd, &clientRect);
+        width = clientRect.right;
+        height = clientRect.bottom;
+
+        HDC hdc = GetDC(hwnd);
+        backDC = CreateCompatibleDC(hdc);
+        backBitmap = CreateCompatibleBitmap(hdc, width, height);
+        oldBackBitmap = (HBITMAP)SelectObject(backDC, backBitmap);
+
+        font = CreateFontW(-12, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE, DEFAULT_CHARSET,
+            OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, CLEARTYPE_QUALITY, FIXED_PITCH | FF_MODERN, L"Consolas");
+        atlasDC = CreateCompatibleDC(hdc);
+        HFONT oldFont = (HFONT)SelectObject(atlasDC, font);
+        TEXTMETRICW metrics;
+        GetTextMetricsW(atlasDC, &metrics);
+        cellWidth = metrics.tmAveCharWidth;
+        cellHeight = metrics.tmHeight;
+
+        // Rasterise ' '..'~' once, side by side
+        atlasBitmap = CreateCompatibleBitmap(hdc, kGlyphCount * cellWidth, cellHeight);
+        oldAtlasBitmap = (HBITMAP)SelectObject(atlasDC, atlasBitmap);
+        RECT atlasRect = { 0, 0, kGlyphCount * cellWidth, cellHeight };
+        FillRect(atlasDC, &atlasRect, (HBRUSH)GetStockObject(BLACK_BRUSH));
+        SetTextColor(atlasDC, RGB(255, 255, 255));
+        SetBkMode(atlasDC, TRANSPARENT);
+        for (int i = 0; i < kGlyphCount; i++) {
+            wchar_t ch = (wchar_t)(32 + i);
+            TextOutW(atlasDC, i * cellWidth, 0, &ch, 1);
+        }
+        SelectObject(atlasDC, oldFont);
+
+        ReleaseDC(hwnd, hdc);
+        return backBitmap && atlasBitmap;
+    }
+
+    int Width() const override { return width; }
+    int Height() const override { return height; }
+    int CellWidth() const override { return cellWidth; }
+    int CellHeight() const override { return cellHeight; }
+
+    void FillBackground(const OverlayRect& rect) override {
+        RECT r = { rect.left, rect.top, rect.right, rect.bottom };
+        FillRect(backDC, &r, (HBRUSH)GetStockObject(BLACK_BRUSH));
+    }
+
+    void DrawGlyph(wchar_t ch, int x, int y) override {
+        int index = (ch >= 32 && ch < 32 + kGlyphCount) ? ch - 32 : '?' - 32;
+        BitBlt(backDC, x, y, cellWidth, cellHeight, atlasDC, index * cellWidth, 0, SRCCOPY);
+    }
+
+    void Present(HDC hdc, const RECT& area) {
+        BitBlt(hdc, area.left, area.top, area.right - area.left, area.bottom - area.top,
+            backDC, area.left, area.top, SRCCOPY);
+    }
+
+private:
+    static const int kGlyphCount = 95;
+
+    void Destroy() {
+        if (backDC) {
+            SelectObject(backDC, oldBackBitmap);
+            DeleteDC(backDC);
+        }
+        if (atlasDC) {
+            SelectObject(atlasDC, oldAtlasBitmap);
+            DeleteDC(atlasDC);
+        }
+        if (backBitmap) DeleteObject(backBitmap);
+        if (atlasBitmap) DeleteObject(atlasBitmap);
+        if (font) DeleteObject(font);
+        backDC = atlasDC = nullptr;
+        backBitmap = oldBackBitmap = atlasBitmap = oldAtlasBitmap = nullptr;
+        font = nullptr;
+    }
+
+    int width = 0, height = 0;
+    int cellWidth = 1, cellHeight = 1;
+    HDC backDC = nullptr;
+    HBITMAP backBitmap = nullptr, oldBackBitmap = nullptr;
+    HDC atlasDC = nullptr;
+    HBITMAP atlasBitmap = nullptr, oldAtlasBitmap = nullptr;
+    HFONT font = nullptr;
+};
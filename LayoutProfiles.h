@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+
+// Where and how the F3 "XYZ:" line is drawn, per game version and font.
+// firstRow and leftMargin are unscaled pixels of the captured window,
+// including its title bar and border. Everything else is in font pixels,
+// which the decoder multiplies by the scale it measures from the first
+// stroke.
+//
+// The decoder is instantiated once per profile, so all of these fold into
+// constants and decoding never branches on the version.
+//
+// Every profile needs a trait the others lack, or detection can never pick
+// it: its own text colour, a background box to check, or its own glyphs.
+// Profiles are tried in kDetectionOrder, strictest first.
+
+enum class LayoutId : int {
+    Modern,         // 1.13 - 1.19, plain white text
+    Legacy,         // 1.8 / 1.12 speedrun versions, light grey text
+    TextBackground, // 1.20+, text drawn on a background box
+    Unicode,        // "Force Unicode Font" enabled
+    Count
+};
+
+// One glyph column per character, sampled at the glyph's first inked column
+// over `rows` text rows; the top row is the high bit.
+struct GlyphColumns {
+    int rows;
+    unsigned int digits[10];
+    unsigned int minus;
+    unsigned int separator;   // the ',' after x and y; other columns are ignored
+    int digitAdvance[10];     // font pixels to the next glyph; 0 = the profile's glyphAdvance
+};
+
+// The default bitmap font: 5x7 glyphs, fixed 6 pixel advance for digits.
+const GlyphColumns kDefaultFontGlyphs = {
+    7,
+    { 0b0111110, 0b0000001, 0b0100011, 0b0100010, 0b0001100,
+      0b1110010, 0b0011110, 0b1100000, 0b0110110, 0b0110000 },
+    0b0001000,
+    0b0000011,
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+};
+
+// The Unicode font is GNU Unifont drawn at half a GUI pixel per font pixel,
+// with each glyph trimmed to its inked columns. Digits are 10 rows tall and
+// 8 font pixels apart, except the narrower '1'.
+const GlyphColumns kUnicodeFontGlyphs = {
+    10,
+    { 0b0011111100, 0b0010000001, 0b0110000111, 0b0110000110, 0b0000111000,
+      0b1111100010, 0b0011111110, 0b1000000000, 0b0111011110, 0b0111000000 },
+    0b0000100000,
+    0b0000000100,
+    { 0, 7, 0, 0, 0, 0, 0, 0, 0, 0 },
+};
+
+struct LayoutModern {
+    static constexpr LayoutId id = LayoutId::Modern;
+    static constexpr int firstRow = 30;          // below the title bar
+    static constexpr int leftMargin = 8;         // window border
+    static constexpr int streakUnit = 4;         // width of the first stroke at scale 1
+    static constexpr int prefixWidth = 44;       // "XYZ:" up to the first digit
+    static constexpr int glyphAdvance = 6;
+    static constexpr uint32_t textColor = 0xFFFFFFFF;
+    static constexpr bool hasBackground = false;
+    static constexpr uint32_t backgroundColor = 0;
+    static constexpr int backgroundTolerance = 0;
+    static const GlyphColumns& Glyphs() { return kDefaultFontGlyphs; }
+};
+
+// Same font and placement; the debug text is light grey instead of white.
+struct LayoutLegacy : LayoutModern {
+    static constexpr LayoutId id = LayoutId::Legacy;
+    static constexpr uint32_t textColor = 0xFFE0E0E0;
+};
+
+// White text on a grey box that pads it by one font pixel. The box is
+// translucent, so it only has to be close to its own colour.
+struct LayoutTextBackground : LayoutModern {
+    static constexpr LayoutId id = LayoutId::TextBackground;
+    static constexpr bool hasBackground = true;
+    static constexpr uint32_t backgroundColor = 0xFF505050;
+    static constexpr int backgroundTolerance = 0x30;
+};
+
+// Font pixels are half the size of the default font's, so the stroke and
+// prefix measure twice as many of them.
+struct LayoutUnicode : LayoutModern {
+    static constexpr LayoutId id = LayoutId::Unicode;
+    static constexpr int streakUnit = 8;
+    static constexpr int prefixWidth = 88;
+    static constexpr int glyphAdvance = 8;
+    static const GlyphColumns& Glyphs() { return kUnicodeFontGlyphs; }
+};
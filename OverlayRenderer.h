@@ -0,0 +1,238 @@
+#pragma once
+
+#include "CoordinateDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+const uint32_t kOverlayBackground = 0xFF000000;
+const uint32_t kOverlayForeground = 0xFFFFFFFF;
+
+struct OverlayRect {
+    int left, top, right, bottom;
+};
+
+// Overlay text for a reading: the player position, the 4x4 to dig at and the
+// distance to it. A negative `cpuMsPerMinute` leaves out the CPU line, which
+// is only shown while auto read is on.
+inline std::wstring FormatReadingText(const Vec3& player, const Vec3& spot, int cpuMsPerMinute = -1) {
+    int distX = abs(player.x - spot.x);
+    int distZ = abs(player.z - spot.z);
+    double totalDist = sqrt(distX * distX + distZ * distZ);
+
+    std::wstring text;
+    text += L"Player: " + std::to_wstring(player.x) + L", " + std::to_wstring(player.y) + L", " + std::to_wstring(player.z) + L"\n";
+    text += L"4x4: " + std::to_wstring(spot.x) + L", " + std::to_wstring(spot.y) + L", " + std::to_wstring(spot.z) + L"\n";
+    text += L"Dist: " + std::to_wstring((int)totalDist) + L" blocks";
+    if (cpuMsPerMinute >= 0) {
+        text += L"\nCPU: " + std::to_wstring(cpuMsPerMinute) + L" ms/min";
+    }
+    return text;
+}
+
+// Where the overlay text ends up. Glyphs come from an atlas rasterised once,
+// and every glyph fills its whole cell, so redrawing a span never needs the
+// previous contents.
+class OverlaySurface {
+public:
+    virtual ~OverlaySurface() = default;
+
+    virtual int Width() const = 0;
+    virtual int Height() const = 0;
+    virtual int CellWidth() const = 0;
+    virtual int CellHeight() const = 0;
+
+    virtual void FillBackground(const OverlayRect& rect) = 0;
+    virtual void DrawGlyph(wchar_t ch, int x, int y) = 0;
+};
+
+// Lays the overlay text out on a fixed cell grid and, on each update, only
+// redraws the runs of cells whose character changed. When just the distance
+// digits move, that is a couple of cells instead of the whole window.
+class OverlayRenderer {
+public:
+    static const int kPadding = 5;
+
+    explicit OverlayRenderer(OverlaySurface& surface) : surface(surface) {}
+
+    void InvalidateAll() {
+        fullRedraw = true;
+    }
+
+    // Draws `text` into the surface and returns the areas that changed.
+    const std::vector<OverlayRect>& SetText(const std::wstring& text) {
+        dirty.clear();
+
+        if (surface.Width() != width || surface.Height() != height) {
+            width = surface.Width();
+            height = surface.Height();
+            columns = (std::max)(1, (width - 2 * kPadding) / surface.CellWidth());
+            rows = (std::max)(1, (height - 2 * kPadding) / surface.CellHeight());
+            fullRedraw = true;
+        }
+
+        std::vector<std::wstring> lines = Layout(text);
+
+        if (fullRedraw) {
+            OverlayRect all = { 0, 0, width, height };
+            surface.FillBackground(all);
+            for (int row = 0; row < rows; row++) DrawSpan(lines[row], row, 0, columns);
+            dirty.push_back(all);
+            fullRedraw = false;
+        }
+        else {
+            for (int row = 0; row < rows; row++) {
+                const std::wstring& before = shown[row];
+                const std::wstring& after = lines[row];
+                for (int col = 0; col < columns; ) {
+                    if (before[col] == after[col]) { col++; continue; }
+                    int end = col + 1;
+                    while (end < columns && before[end] != after[end]) end++;
+                    dirty.push_back(DrawSpan(after, row, col, end));
+                    col = end;
+                }
+            }
+        }
+
+        shown.swap(lines);
+        return dirty;
+    }
+
+private:
+    OverlayRect DrawSpan(const std::wstring& line, int row, int begin, int end) {
+        int cw = surface.CellWidth();
+        int ch = surface.CellHeight();
+        OverlayRect rect = { kPadding + begin * cw, kPadding + row * ch, kPadding + end * cw, kPadding + (row + 1) * ch };
+        surface.FillBackground(rect);
+        for (int col = begin; col < end; col++) {
+            if (line[col] != L' ') surface.DrawGlyph(line[col], kPadding + col * cw, rect.top);
+        }
+        return rect;
+    }
+
+    // Splits on newlines, word-wraps to the grid width and pads every row to
+    // exactly `columns` cells so rows can be compared cell by cell.
+    std::vector<std::wstring> Layout(const std::wstring& text) const {
+        std::vector<std::wstring> lines;
+        size_t start = 0;
+        while (start <= text.size() && (int)lines.size() < rows) {
+            size_t newline = text.find(L'\n', start);
+            std::wstring paragraph = text.substr(start, newline == std::wstring::npos ? std::wstring::npos : newline - start);
+            start = newline == std::wstring::npos ? text.size() + 1 : newline + 1;
+
+            do {
+                size_t cut = paragraph.size();
+                if ((int)cut > columns) {
+                    size_t space = paragraph.rfind(L' ', columns);
+                    cut = (space == std::wstring::npos || space == 0) ? columns : space;
+                }
+                lines.push_back(paragraph.substr(0, cut));
+                size_t next = paragraph.find_first_not_of(L' ', cut);
+                paragraph = next == std::wstring::npos ? std::wstring() : paragraph.substr(next);
+            } while (!paragraph.empty() && (int)lines.size() < rows);
+        }
+
+        lines.resize(rows);
+        for (auto& line : lines) line.resize(columns, L' ');
+        return lines;
+    }
+
+    OverlaySurface& surface;
+    int width = -1, height = -1;
+    int columns = 0, rows = 0;
+    bool fullRedraw = true;
+    std::vector<std::wstring> shown;
+    std::vector<OverlayRect> dirty;
+};
+
+// Pure software surface with a built-in 5x7 font, so paint cost can be
+// measured and pixels compared without a window system.
+class SoftwareOverlaySurface : public OverlaySurface {
+public:
+    SoftwareOverlaySurface(int width, int height)
+        : width(width), height(height), pixels(width * height, kOverlayBackground) {
+        BuildAtlas();
+    }
+
+    int Width() const override { return width; }
+    int Height() const override { return height; }
+    int CellWidth() const override { return kCellWidth; }
+    int CellHeight() const override { return kCellHeight; }
+
+    void FillBackground(const OverlayRect& rect) override {
+        OverlayRect r = Clip(rect);
+        if (r.right <= r.left) return;
+        for (int y = r.top; y < r.bottom; y++)
+            std::fill(pixels.begin() + y * width + r.left, pixels.begin() + y * width + r.right, kOverlayBackground);
+    }
+
+    void DrawGlyph(wchar_t ch, int x, int y) override {
+        int index = (ch >= 32 && ch < 127) ? ch - 32 : '?' - 32;
+        OverlayRect r = Clip({ x, y, x + kCellWidth, y + kCellHeight });
+        if (r.right <= r.left) return;
+        for (int py = r.top; py < r.bottom; py++) {
+            const uint32_t* src = &atlas[(py - y) * kAtlasWidth + index * kCellWidth + (r.left - x)];
+            std::copy(src, src + (r.right - r.left), pixels.begin() + py * width + r.left);
+        }
+    }
+
+    const std::vector<uint32_t>& Pixels() const { return pixels; }
+
+private:
+    static const int kCellWidth = 6;
+    static const int kCellHeight = 9;
+    static const int kAtlasWidth = 95 * kCellWidth;
+
+    OverlayRect Clip(const OverlayRect& rect) const {
+        return { (std::max)(rect.left, 0), (std::max)(rect.top, 0),
+            (std::min)(rect.right, width), (std::min)(rect.bottom, height) };
+    }
+
+    // Classic 5x7 font for ' '..'~', one byte per column, bit 0 at the top
+    void BuildAtlas() {
+        static const uint8_t font[95][5] = {
+            {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},
+            {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00},
+            {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x08,0x2A,0x1C,0x2A,0x08}, {0x08,0x08,0x3E,0x08,0x08},
+            {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02},
+            {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31},
+            {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+            {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00},
+            {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06},
+            {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+            {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x01,0x01}, {0x3E,0x41,0x41,0x51,0x32},
+            {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},
+            {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x04,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+            {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31},
+            {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x7F,0x20,0x18,0x20,0x7F},
+            {0x63,0x14,0x08,0x14,0x63}, {0x03,0x04,0x78,0x04,0x03}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+            {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40},
+            {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20},
+            {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x08,0x14,0x54,0x54,0x3C},
+            {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x00,0x7F,0x10,0x28,0x44},
+            {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38},
+            {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20},
+            {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C},
+            {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00},
+            {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08},
+        };
+
+        atlas.assign(kAtlasWidth * kCellHeight, kOverlayBackground);
+        for (int index = 0; index < 95; index++) {
+            for (int col = 0; col < 5; col++) {
+                for (int bit = 0; bit < 7; bit++) {
+                    if (font[index][col] & (1 << bit))
+                        atlas[(bit + 1) * kAtlasWidth + index * kCellWidth + col] = kOverlayForeground;
+                }
+            }
+        }
+    }
+
+    int width, height;
+    std::vector<uint32_t> pixels;
+    std::vector<uint32_t> atlas;   // all glyphs side by side, one cell each
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoordinateDecoder.h"
+
+#include <algorithm>
+
+// Picks the delay before the next capture. Polls slowly while the player
+// stands still, F3 is closed or the game is in the background, and faster
+// while they move: the interval is a fraction of the time they need, at
+// their current speed, to get within `nearBlocks` of the target.
+//
+// The app passes the 4x4 from the last hotkey read as the target, so a long
+// walk stays slow and only the final approach to that spot polls fast.
+// Before the first hotkey read it falls back to the 4x4 nearest to the
+// current position, which every chunk crossed brings within `nearBlocks`.
+class PollScheduler {
+public:
+    struct Settings {
+        double maxHz = 60.0;                 // game frame rate
+        double idleIntervalMs = 2000.0;      // standing still or nothing to read
+        double unfocusedIntervalMs = 5000.0; // game window not in the foreground
+        double nearBlocks = 3.0;             // poll at maxHz within this distance
+        double stillSpeed = 0.2;             // blocks per second that count as standing
+        double samplesPerApproach = 4.0;     // readings wanted before reaching nearBlocks
+    };
+
+    PollScheduler() = default;
+    explicit PollScheduler(const Settings& settings) : settings(settings) {}
+
+    // Feed every successful reading, with the spot being walked to.
+    void OnReading(const Vec3& position, const Vec3& target, double nowMs) {
+        // F3 shows whole blocks, so at high poll rates most consecutive
+        // readings are identical; measure speed over at least kSpeedWindowMs.
+        if (!hasAnchor) {
+            anchor = position;
+            anchorMs = nowMs;
+            hasAnchor = true;
+        }
+        else if (nowMs - anchorMs >= kSpeedWindowMs) {
+            speed = HorizontalDistance(position, anchor) / ((nowMs - anchorMs) / 1000.0);
+            hasSpeed = true;
+            anchor = position;
+            anchorMs = nowMs;
+        }
+        distance = HorizontalDistance(position, target);
+    }
+
+    // F3 not visible or the window is gone: fall back to idle polling and
+    // start the speed estimate over once readings come back.
+    void OnNoReading() {
+        hasAnchor = false;
+        hasSpeed = false;
+        distance = -1.0;
+    }
+
+    double NextIntervalMs(bool focused) const {
+        if (!focused) return settings.unfocusedIntervalMs;
+        if (distance < 0.0) return settings.idleIntervalMs;
+        if (!hasSpeed) return kSpeedWindowMs;   // one more reading gives the speed
+        if (speed < settings.stillSpeed) return settings.idleIntervalMs;
+
+        double minIntervalMs = 1000.0 / settings.maxHz;
+        if (distance <= settings.nearBlocks) return minIntervalMs;
+
+        double arriveMs = (distance - settings.nearBlocks) / speed * 1000.0;
+        return (std::min)((std::max)(arriveMs / settings.samplesPerApproach, minIntervalMs), settings.idleIntervalMs);
+    }
+
+    double Speed() const { return hasSpeed ? speed : 0.0; }
+
+private:
+    static constexpr double kSpeedWindowMs = 250.0;
+
+    Settings settings;
+    Vec3 anchor = { 0, 0, 0 };
+    double anchorMs = 0.0;
+    bool hasAnchor = false;
+    double speed = 0.0;
+    bool hasSpeed = false;
+    double distance = -1.0;
+};
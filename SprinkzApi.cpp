@@ -0,0 +1,76 @@
+#include "SprinkzApi.h"
+#include "CoordinateDecoder.h"
+
+int32_t sprinkz_api_version(void) {
+    return SPRINKZ_API_VERSION;
+}
+
+int64_t sprinkz_decode_batch(const uint8_t* data, const int64_t shape[4], const int64_t strides[4],
+    const sprinkz_decode_options* options, int32_t* out_coords, uint8_t* out_found) {
+    if (!shape || !strides || !out_coords || !out_found) return SPRINKZ_E_INVALID_ARG;
+
+    int tolerance = 0;
+    if (options) {
+        if (options->size < sizeof(sprinkz_decode_options)) return SPRINKZ_E_INVALID_ARG;
+        if (options->tolerance < 0 || options->tolerance > 255) return SPRINKZ_E_INVALID_ARG;
+        tolerance = options->tolerance;
+    }
+
+    int64_t count = shape[0];
+    int64_t height = shape[1];
+    int64_t width = shape[2];
+    int64_t channels = shape[3];
+    if (count < 0 || height < 0 || width < 0 || height > INT32_MAX || width > INT32_MAX)
+        return SPRINKZ_E_INVALID_ARG;
+    if (count == 0) return 0;   // NumPy gives empty arrays all-zero strides
+    if (count > 0 && !data) return SPRINKZ_E_INVALID_ARG;
+    if ((channels != 3 && channels != 4) || strides[3] != 1) return SPRINKZ_E_LAYOUT;
+
+    // Three-channel pixels are read as four bytes and the spare byte masked
+    // off. The search region never includes the last row, so this never
+    // reads past the end of the buffer.
+    PixelView view;
+    view.rowStride = strides[1];
+    view.pixelStride = strides[2];
+    view.width = (int)width;
+    view.height = (int)height;
+    view.colorMask = channels == 4 ? 0xFFFFFFFF : 0x00FFFFFF;
+    view.tolerance = tolerance;
+    PixelView region = CropToSearchRegion(view);
+
+    // Frames in one batch come from one source, so the layout is detected
+    // once and reused; a frame it fails on is detected again. Kept in a local
+    // rather than a LayoutCache, which would allocate.
+    LayoutId layout = LayoutId::Count;
+    int64_t decoded = 0;
+    for (int64_t i = 0; i < count; i++) {
+        region.base = data + i * strides[0];
+        Vec3 coordinates = { 0, 0, 0 };
+        bool found = false;
+        if (region.height > 0) {
+            int fields = 0;
+            found = layout != LayoutId::Count && kLayoutDecoders[(int)layout](region, &coordinates, &fields)
+                && fields == 3;
+            if (!found) found = DetectLayout(region, &layout, &coordinates);
+        }
+        if (!found) coordinates = { 0, 0, 0 };   // partial reads are noise
+        out_coords[i * 3 + 0] = coordinates.x;
+        out_coords[i * 3 + 1] = coordinates.y;
+        out_coords[i * 3 + 2] = coordinates.z;
+        out_found[i] = found ? 1 : 0;
+        if (found) decoded++;
+    }
+    return decoded;
+}
+
+int32_t sprinkz_nearest_4x4_batch(const int32_t* positions, int64_t count, int32_t* out_spots) {
+    if (count < 0 || (count > 0 && (!positions || !out_spots))) return SPRINKZ_E_INVALID_ARG;
+
+    for (int64_t i = 0; i < count; i++) {
+        Vec3 spot = CalculateNearest4x4Coordinate({ positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2] });
+        out_spots[i * 3 + 0] = spot.x;
+        out_spots[i * 3 + 1] = spot.y;
+        out_spots[i * 3 + 2] = spot.z;
+    }
+    return SPRINKZ_OK;
+}
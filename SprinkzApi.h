@@ -0,0 +1,77 @@
+#pragma once
+
+/*
+ * Stable C ABI over the F3 decoder and 4x4 rounding, for use from other
+ * languages (see python/sprinkz.py). Build as a shared library:
+ *
+ *   cl /LD /O2 /DSPRINKZ_BUILD_DLL SprinkzApi.cpp /Fe:sprinkz.dll
+ *   g++ -shared -fPIC -O2 SprinkzApi.cpp -o libsprinkz.so
+ *
+ * Functions never allocate and never keep pointers past the call, so callers
+ * may run them concurrently on different buffers.
+ */
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(SPRINKZ_BUILD_DLL)
+#    define SPRINKZ_API __declspec(dllexport)
+#  else
+#    define SPRINKZ_API __declspec(dllimport)
+#  endif
+#else
+#  define SPRINKZ_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPRINKZ_API_VERSION 1
+
+/* Return codes; batch calls return the number of frames decoded instead of OK. */
+#define SPRINKZ_OK              0
+#define SPRINKZ_E_INVALID_ARG  -1
+#define SPRINKZ_E_LAYOUT       -2   /* channels not 3/4 or not contiguous */
+
+SPRINKZ_API int32_t sprinkz_api_version(void);
+
+/* Suggested tolerance for frames decoded from lossy video (H.264, HEVC). */
+#define SPRINKZ_VIDEO_TOLERANCE 31
+
+/*
+ * Decode options. Set size to sizeof(sprinkz_decode_options); later API
+ * versions only append fields, and read them only if size covers them.
+ */
+typedef struct sprinkz_decode_options {
+    uint32_t size;
+    int32_t tolerance;   /* per channel, 0-255; 0 = exact text colour (screen captures) */
+} sprinkz_decode_options;
+
+/*
+ * Decodes a batch of frames laid out as uint8 [count, height, width, channels]
+ * with arbitrary byte strides, e.g. a NumPy array or a slice of one. Channels
+ * must be 3 (BGR/RGB) or 4 (BGRA/RGBA) with a channel stride of 1.
+ * options may be NULL for the defaults (exact colour match).
+ *
+ * out_coords receives count * 3 int32 values (x, y, z per frame) and
+ * out_found count flags (1 if the frame showed readable coordinates).
+ * Returns the number of frames with coordinates, or a negative error code.
+ */
+SPRINKZ_API int64_t sprinkz_decode_batch(
+    const uint8_t* data,
+    const int64_t shape[4],
+    const int64_t strides[4],
+    const sprinkz_decode_options* options,
+    int32_t* out_coords,
+    uint8_t* out_found);
+
+/* Rounds count positions (x, y, z triples) to the nearest 4x4 dig spot. */
+SPRINKZ_API int32_t sprinkz_nearest_4x4_batch(
+    const int32_t* positions,
+    int64_t count,
+    int32_t* out_spots);
+
+#ifdef __cplusplus
+}
+#endif
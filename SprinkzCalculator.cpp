@@ -6,14 +6,27 @@
 #include <gdiplus.h>
 #include <memory>
 #include <string>
-#include <sstream>
 #include <fstream>
+#include <limits>
+#include <utility>
+#include <vector>
 #include <commctrl.h>
+#include <shellapi.h>
+#include <cstdio>
+
+#include "CoordinateDecoder.h"
+#include "CoordinateTimeline.h"
+#include "CpuMeter.h"
+#include "GdiOverlaySurface.h"
+#include "PollScheduler.h"
+#include "Win32WindowRegistry.h"
+#include "MediaFoundationFrameSource.h"
 
 #pragma comment(lib, "gdiplus.lib")
 #pragma comment(lib, "user32.lib")
 #pragma comment(lib, "gdi32.lib")
 #pragma comment(lib, "comctl32.lib")
+#pragma comment(lib, "shell32.lib")
 
 using namespace Gdiplus;
 using namespace std;
@@ -21,6 +34,8 @@ using namespace std;
 // Constants
 const int WM_HOTKEY_PRESSED = WM_USER + 1;
 const int HOTKEY_ID = 1;
+const int POLL_TIMER_ID = 2;
+const UINT FIXED_POLL_INTERVAL_MS = 50;   // 20 Hz, for comparing against adaptive polling
 const wchar_t* CONFIG_FILE = L"chunk_finder_config.txt";
 
 // Control IDs for options window
@@ -30,17 +45,29 @@ const wchar_t* CONFIG_FILE = L"chunk_finder_config.txt";
 #define IDC_SAVE_BTN           3004
 #define IDC_DEFAULTS_BTN       3005
 #define IDC_CLOSE_BTN          3006
+#define IDC_POLL_COMBO         3007
 
-struct Vec3 {
-    int x, y, z;
+enum PollMode {
+    POLL_OFF = 0,       // read only on hotkey
+    POLL_ADAPTIVE = 1,  // PollScheduler picks the interval
+    POLL_FIXED = 2      // every FIXED_POLL_INTERVAL_MS
 };
 
+// The default window rules as config lines: a class list, then a title list.
+static vector<pair<string, string>> DefaultWindowRules() {
+    vector<pair<string, string>> rules;
+    for (const WindowRuleText& rule : kDefaultWindowRules) rules.emplace_back(rule.classes, rule.titles);
+    return rules;
+}
+
 struct Config {
     UINT hotkeyVK = VK_F8;          // Default F8
     UINT hotkeyMod = MOD_NOREPEAT;   // No modifier by default
     bool overlayVisible = true;
     int overlayX = -1;               // -1 means use default position
     int overlayY = -1;
+    int pollMode = POLL_OFF;
+    vector<pair<string, string>> windowRules = DefaultWindowRules();  // see WindowPatterns
 };
 
 // Global variables for options window
@@ -59,7 +86,15 @@ private:
     Vec3 lastCoordinates;
     Vec3 nearestChunkCoord;
     bool coordinatesFound;
+    Vec3 digTarget;            // the 4x4 from the last hotkey read; paces auto reads
+    bool hasDigTarget;
     Config config;
+    LayoutCache layouts;
+    PollScheduler pollScheduler;
+    CpuMeter cpuMeter;
+    Win32WindowRegistry windowRegistry;
+    GdiOverlaySurface overlaySurface;
+    unique_ptr<OverlayRenderer> overlayRenderer;
     bool isDragging;
     POINT dragOffset;
 
@@ -79,9 +114,19 @@ public:
         coordinatesFound = false;
         lastCoordinates = { 0, 0, 0 };
         nearestChunkCoord = { 0, 0, 0 };
+        digTarget = { 0, 0, 0 };
+        hasDigTarget = false;
         isDragging = false;
 
         LoadConfig();
+        WindowPatterns patterns;
+        for (const auto& rule : config.windowRules) patterns.Add(rule.first, rule.second);
+        windowRegistry.SetPatterns(patterns);
+        windowRegistry.SetTrace([](double lookupUs, bool found) {
+            wchar_t message[96];
+            swprintf_s(message, L"ChunkFinder: window lookup %.1f us (%ls)\n", lookupUs, found ? L"found" : L"not found");
+            OutputDebugStringW(message);
+        });
     }
 
     ~ChunkCoordinateFinder() {
@@ -94,6 +139,20 @@ public:
         ifstream file(CONFIG_FILE);
         if (file.is_open()) {
             file >> config.hotkeyVK >> config.hotkeyMod >> config.overlayVisible >> config.overlayX >> config.overlayY;
+            file >> config.pollMode;   // absent in older config files, which then read as POLL_OFF
+            if (config.pollMode < POLL_OFF || config.pollMode > POLL_FIXED) config.pollMode = POLL_OFF;
+
+            // Window rules, a class line and a title line each, to the end of
+            // the file; older files end before them. A blank line is an empty
+            // list, which matches any window.
+            vector<pair<string, string>> rules;
+            string classes, titles;
+            file.ignore((numeric_limits<streamsize>::max)(), '\n');
+            while (getline(file, classes) && getline(file, titles)) rules.emplace_back(classes, titles);
+            // The previous single default rule missed LWJGL windows without
+            // "Minecraft" in the title; files that only saved it get the new ones
+            bool oldDefault = rules.size() == 1 && rules[0].first == "LWJGL;GLFW30" && rules[0].second == "*Minecraft*";
+            if (!rules.empty() && !oldDefault) config.windowRules = rules;
             file.close();
         }
     }
@@ -107,7 +166,8 @@ public:
             config.overlayY = rect.top;
 
             file << config.hotkeyVK << " " << config.hotkeyMod << " " << config.overlayVisible
-                << " " << config.overlayX << " " << config.overlayY;
+                << " " << config.overlayX << " " << config.overlayY << " " << config.pollMode << "\n";
+            for (const auto& rule : config.windowRules) file << rule.first << "\n" << rule.second << "\n";
             file.close();
         }
     }
@@ -154,7 +214,6 @@ public:
     unique_ptr<Bitmap> BitmapFromHWND(HWND hwnd) {
         if (!hwnd || !IsWindow(hwnd)) return nullptr;
 
-        if (IsIconic(hwnd)) ShowWindow(hwnd, SW_RESTORE);
         RECT rc;
         GetWindowRect(hwnd, &rc);
         int width = rc.right - rc.left;
@@ -179,160 +238,117 @@ public:
         auto pBitmap = BitmapFromHWND(hwnd);
         if (!pBitmap) return 0;
 
-        int width = pBitmap->GetWidth();
-        int height = pBitmap->GetHeight();
-        int searchWidth = max(width / 3, min(125, width));
-        int searchHeight = height / 3;
+        PixelView region = CropToSearchRegion({ nullptr, 0, 4, (int)pBitmap->GetWidth(), (int)pBitmap->GetHeight() });
         BitmapData bitmapData;
-        Rect rect(0, 0, searchWidth, searchHeight);
+        Rect rect(0, 0, region.width, region.height);
 
         if (pBitmap->LockBits(&rect, ImageLockModeRead, PixelFormat32bppARGB, &bitmapData) != Ok) {
             return 0;
         }
 
-        int startTextX = 0, startTextY = 0, streak = 0;
-        int stride = bitmapData.Stride / sizeof(ARGB);
-        ARGB* pixels = static_cast<ARGB*>(bitmapData.Scan0);
-
-        for (int y = 30; y < searchHeight; y++) {
-            for (int x = 8; x < searchWidth; x++) {
-                if (pixels[y * stride + x] == 0xFFFFFFFF) {
-                    if (!startTextX) { startTextX = x; startTextY = y; }
-                    streak++;
-                }
-                else if (streak < 4) streak = 0;
-                else if (streak >= 4) break;
-            }
-            if (streak >= 4) break;
-        }
-
-        if (streak < 4) {
-            pBitmap->UnlockBits(&bitmapData);
-            return 0;
-        }
-
-        int scale = streak / 4;
-        startTextX += 44 * scale;
-        int coords[3] = { 0, 0, 0 };
-        int index = 0;
-        bool isSigned = false;
-
-        while (startTextX < searchWidth) {
-            unsigned int columnMask = 0;
-            for (int dy = 0; dy < 7; dy++) {
-                columnMask <<= 1;
-                if (pixels[(startTextY + dy * scale) * stride + startTextX] == 0xFFFFFFFF)
-                    columnMask |= 1;
-            }
-
-            int digit = -1;
-            switch (columnMask) {
-            case 0b0111110: digit = 0; break;
-            case 0b0000001: digit = 1; break;
-            case 0b0100011: digit = 2; break;
-            case 0b0100010: digit = 3; break;
-            case 0b0001100: digit = 4; break;
-            case 0b1110010: digit = 5; break;
-            case 0b0011110: digit = 6; break;
-            case 0b1100000: digit = 7; break;
-            case 0b0110110: digit = 8; break;
-            case 0b0110000: digit = 9; break;
-            case 0b0001000: isSigned = true; break;
-            case 0b0000011:
-                if (isSigned) coords[index] *= -1;
-                if (++index > 2) break;
-                isSigned = false;
-                break;
-            default:
-                if (index >= 2) break;
-                if (isSigned) coords[index] *= -1;
-                break;
-            }
-            if (digit != -1)
-                coords[index] = coords[index] * 10 + digit;
-            startTextX += 6 * scale;
-        }
-
-        if (isSigned && index <= 2) {
-            coords[index] *= -1;
-        }
+        region.base = static_cast<const uint8_t*>(bitmapData.Scan0);
+        region.rowStride = bitmapData.Stride;
+        bool found = layouts.Decode((uintptr_t)hwnd, region, coordinates);
 
         pBitmap->UnlockBits(&bitmapData);
-        coordinates->x = coords[0];
-        coordinates->y = coords[1];
-        coordinates->z = coords[2];
-        return 1;
+        return found ? 1 : 0;
     }
 
+    // Cached by the registry; only enumerates windows again after the game
+    // window was destroyed, renamed or resized. The dropped window's layout
+    // is forgotten, since its handle may come back as a different window.
     void findMinecraftWindow() {
-        minecraftWindow = FindWindowA("LWJGL", nullptr);
-        if (!minecraftWindow) {
-            minecraftWindow = FindWindowA(nullptr, "Minecraft");
-        }
+        HWND previous = minecraftWindow;
+        uint64_t lookups = windowRegistry.Stats().lookups;
+        minecraftWindow = windowRegistry.Resolve();
+        if (previous && windowRegistry.Stats().lookups != lookups) layouts.Forget((uintptr_t)previous);
     }
 
     Vec3 calculateNearest4x4Coordinate(const Vec3& playerPos) {
-        Vec3 nearest;
-
-        auto roundToNearestChunkCoord = [](int coord) -> int {
-            // Calculate which chunk the coordinate is in
-            // Chunks are 16 blocks wide, starting at multiples of 16
-            // The 4x4 center is at chunk_start + 4
-
-            int chunkStart;
-            if (coord >= 0) {
-                chunkStart = (coord / 16) * 16;
-            }
-            else {
-                // For negative coordinates, we need floor division
-                chunkStart = ((coord - 15) / 16) * 16;
-            }
-
-            // Find the nearest 4x4 center (either in this chunk or adjacent chunks)
-            int option1 = chunkStart + 4;      // 4x4 center in current chunk
-            int option2 = chunkStart - 12;     // 4x4 center in previous chunk
-            int option3 = chunkStart + 20;     // 4x4 center in next chunk
-
-            // Return the closest one
-            int dist1 = abs(coord - option1);
-            int dist2 = abs(coord - option2);
-            int dist3 = abs(coord - option3);
-
-            if (dist1 <= dist2 && dist1 <= dist3) return option1;
-            if (dist2 <= dist3) return option2;
-            return option3;
-            };
-
-        nearest.x = roundToNearestChunkCoord(playerPos.x);
-        nearest.y = playerPos.y;
-        nearest.z = roundToNearestChunkCoord(playerPos.z);
-
-        return nearest;
+        return CalculateNearest4x4Coordinate(playerPos);
     }
 
-    void updateCoordinates() {
+    // `fromHotkey` reads may restore a minimized game to capture it; timer
+    // reads skip it instead of un-minimizing the game every few seconds.
+    // They also pin the 4x4 shown then as the dig target, which timer reads
+    // keep pacing against until the next hotkey read.
+    void updateCoordinates(bool fromHotkey) {
         findMinecraftWindow();
 
         if (!minecraftWindow || !IsWindow(minecraftWindow)) {
             coordinatesFound = false;
+            pollScheduler.OnNoReading();
+            refreshOverlay();
             return;
         }
 
+        if (IsIconic(minecraftWindow)) {
+            if (!fromHotkey) {
+                pollScheduler.OnNoReading();
+                return;
+            }
+            ShowWindow(minecraftWindow, SW_RESTORE);
+        }
+
         Vec3 currentCoords;
         if (GetShownCoordinates(minecraftWindow, &currentCoords)) {
             lastCoordinates = currentCoords;
             nearestChunkCoord = calculateNearest4x4Coordinate(currentCoords);
             coordinatesFound = true;
-            InvalidateRect(overlayWindow, nullptr, TRUE);
+            if (fromHotkey) {
+                digTarget = nearestChunkCoord;
+                hasDigTarget = true;
+            }
+            pollScheduler.OnReading(lastCoordinates, hasDigTarget ? digTarget : nearestChunkCoord,
+                (double)GetTickCount64());
+            refreshOverlay();
         }
         else {
             coordinatesFound = false;
+            pollScheduler.OnNoReading();
+            refreshOverlay();
         }
     }
 
+    // Re-arms the one-shot poll timer for the next capture.
+    void schedulePoll() {
+        if (config.pollMode == POLL_OFF) {
+            KillTimer(overlayWindow, POLL_TIMER_ID);
+            return;
+        }
+
+        UINT interval = FIXED_POLL_INTERVAL_MS;
+        if (config.pollMode == POLL_ADAPTIVE) {
+            bool focused = minecraftWindow && GetForegroundWindow() == minecraftWindow;
+            interval = (UINT)pollScheduler.NextIntervalMs(focused);
+        }
+        SetTimer(overlayWindow, POLL_TIMER_ID, interval, nullptr);
+    }
+
     void updateHotkey() {
         UnregisterHotKey(overlayWindow, HOTKEY_ID);
         RegisterHotKey(overlayWindow, HOTKEY_ID, config.hotkeyMod, config.hotkeyVK);
+        refreshOverlay();   // the hint text shows the hotkey
+    }
+
+    wstring buildOverlayText() {
+        if (!coordinatesFound) {
+            return L"Press " + GetHotkeyString() + L" to read coords\nMake sure to be decently near to dig spot\nRight-click for settings";
+        }
+
+        int cpuMsPerMinute = config.pollMode != POLL_OFF ? (int)cpuMeter.CpuMsPerMinute() : -1;
+        return FormatReadingText(lastCoordinates, nearestChunkCoord, cpuMsPerMinute);
+    }
+
+    // Redraws the changed parts of the overlay text into the backbuffer and
+    // invalidates only those.
+    void refreshOverlay() {
+        if (!overlayRenderer) return;
+
+        for (const OverlayRect& dirty : overlayRenderer->SetText(buildOverlayText())) {
+            RECT rect = { dirty.left, dirty.top, dirty.right, dirty.bottom };
+            InvalidateRect(overlayWindow, &rect, FALSE);
+        }
     }
 
     wstring GetHotkeyString() {
@@ -408,6 +424,14 @@ public:
                 }
                 break;
 
+            case IDC_POLL_COMBO:
+                if (HIWORD(wParam) == CBN_SELCHANGE) {
+                    HWND hCombo = GetDlgItem(hwnd, IDC_POLL_COMBO);
+                    instance->config.pollMode = (int)SendMessage(hCombo, CB_GETCURSEL, 0, 0);
+                    instance->schedulePoll();
+                }
+                break;
+
             case IDC_SAVE_BTN:
                 instance->SaveConfig();
                 MessageBoxW(hwnd, L"Settings saved successfully!", L"Settings", MB_OK | MB_ICONINFORMATION);
@@ -454,6 +478,9 @@ public:
         else if (config.hotkeyMod & MOD_ALT) sel = 2;
         else if (config.hotkeyMod & MOD_SHIFT) sel = 3;
         SendMessage(hCombo, CB_SETCURSEL, sel, 0);
+
+        // Update polling combo
+        SendMessage(GetDlgItem(g_hOptionsWnd, IDC_POLL_COMBO), CB_SETCURSEL, config.pollMode, 0);
     }
 
     void createOptionsWindow() {
@@ -479,7 +506,7 @@ public:
         int screenWidth = GetSystemMetrics(SM_CXSCREEN);
         int screenHeight = GetSystemMetrics(SM_CYSCREEN);
         int windowWidth = 400;
-        int windowHeight = 250;
+        int windowHeight = 285;
         int x = (screenWidth - windowWidth) / 2;
         int y = (screenHeight - windowHeight) / 2;
 
@@ -532,6 +559,19 @@ public:
         g_originalEditProc = (WNDPROC)SetWindowLongPtrW(hKeyEdit, GWLP_WNDPROC, (LONG_PTR)EditKeyCapture);
         yPos += 35;
 
+        // Polling label and combo
+        CreateWindowW(L"STATIC", L"Auto read:",
+            WS_VISIBLE | WS_CHILD | SS_LEFT,
+            20, yPos, 100, 20, g_hOptionsWnd, nullptr, hInstance, nullptr);
+        HWND hPollCombo = CreateWindowW(L"COMBOBOX", L"",
+            WS_VISIBLE | WS_CHILD | CBS_DROPDOWNLIST | WS_VSCROLL,
+            130, yPos - 2, 120, 100, g_hOptionsWnd, (HMENU)IDC_POLL_COMBO, hInstance, nullptr);
+
+        SendMessageW(hPollCombo, CB_ADDSTRING, 0, (LPARAM)L"Off");
+        SendMessageW(hPollCombo, CB_ADDSTRING, 0, (LPARAM)L"Adaptive");
+        SendMessageW(hPollCombo, CB_ADDSTRING, 0, (LPARAM)L"Fixed 20 Hz");
+        yPos += 35;
+
         // Instructions
         CreateWindowW(L"STATIC", L"Click on the key field and press a key to set it",
             WS_VISIBLE | WS_CHILD | SS_LEFT,
@@ -584,61 +624,29 @@ public:
         switch (uMsg) {
         case WM_HOTKEY:
             if (wParam == HOTKEY_ID) {
-                updateCoordinates();
+                updateCoordinates(true);
+            }
+            break;
+
+        case WM_TIMER:
+            if (wParam == POLL_TIMER_ID) {
+                updateCoordinates(false);
+                cpuMeter.Sample();
+                schedulePoll();
             }
             break;
 
         case WM_PAINT: {
             PAINTSTRUCT ps;
             HDC hdc = BeginPaint(hwnd, &ps);
-
-            // Create memory DC for double buffering
-            RECT clientRect;
-            GetClientRect(hwnd, &clientRect);
-            HDC memDC = CreateCompatibleDC(hdc);
-            HBITMAP memBitmap = CreateCompatibleBitmap(hdc, clientRect.right, clientRect.bottom);
-            HBITMAP oldBitmap = (HBITMAP)SelectObject(memDC, memBitmap);
-
-            // Background
-            HBRUSH bgBrush = CreateSolidBrush(RGB(0, 0, 0));
-            FillRect(memDC, &clientRect, bgBrush);
-            DeleteObject(bgBrush);
-
-            // Text
-            SetTextColor(memDC, RGB(255, 255, 255));
-            SetBkMode(memDC, TRANSPARENT);
-
-            wstring text;
-            if (coordinatesFound) {
-                wstringstream ss;
-                ss << L"Player: " << lastCoordinates.x << L", " << lastCoordinates.y << L", " << lastCoordinates.z << L"\n";
-                ss << L"4x4: " << nearestChunkCoord.x << L", " << nearestChunkCoord.y << L", " << nearestChunkCoord.z << L"\n";
-                int distX = abs(lastCoordinates.x - nearestChunkCoord.x);
-                int distZ = abs(lastCoordinates.z - nearestChunkCoord.z);
-                double totalDist = sqrt(distX * distX + distZ * distZ);
-                ss << L"Dist: " << (int)totalDist << L" blocks";
-                text = ss.str();
-            }
-            else {
-                text = L"Press " + GetHotkeyString() + L" to read coords\nMake sure to be decently near to dig spot\nRight-click for settings";
-            }
-
-            RECT textRect = clientRect;
-            textRect.left += 5;
-            textRect.top += 5;
-            DrawTextW(memDC, text.c_str(), -1, &textRect, DT_LEFT | DT_TOP | DT_WORDBREAK);
-
-            // Copy to main DC
-            BitBlt(hdc, 0, 0, clientRect.right, clientRect.bottom, memDC, 0, 0, SRCCOPY);
-
-            SelectObject(memDC, oldBitmap);
-            DeleteObject(memBitmap);
-            DeleteDC(memDC);
-
+            overlaySurface.Present(hdc, ps.rcPaint);
             EndPaint(hwnd, &ps);
             break;
         }
 
+        case WM_ERASEBKGND:
+            return 1;   // the backbuffer covers the whole client area
+
         case WM_LBUTTONDOWN: {
             isDragging = true;
             POINT cursorPos;
@@ -727,8 +735,13 @@ public:
 
         SetLayeredWindowAttributes(overlayWindow, 0, 220, LWA_ALPHA);
 
+        if (!overlaySurface.Create(overlayWindow)) return false;
+        overlayRenderer = make_unique<OverlayRenderer>(overlaySurface);
+        refreshOverlay();
+
         // Register hotkey
         RegisterHotKey(overlayWindow, HOTKEY_ID, config.hotkeyMod, config.hotkeyVK);
+        schedulePoll();
 
         return true;
     }
@@ -746,7 +759,85 @@ public:
 
 ChunkCoordinateFinder* ChunkCoordinateFinder::instance = nullptr;
 
+// Offline query mode over a recording, e.g.
+//   SprinkzCalculator.exe --vod run.mp4 --near 1204 -340 50 --at 3600
+// Queries run in order against one timeline, so later ones reuse frames
+// decoded by earlier ones.
+static int RunVodQueries(int argc, wchar_t** argv) {
+    const wchar_t* path = nullptr;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (wcscmp(argv[i], L"--vod") == 0) path = argv[i + 1];
+    }
+
+    MediaFoundationFrameSource source;
+    if (!path || !source.Open(path)) {
+        wprintf(L"Could not open recording %ls\n", path ? path : L"(none)");
+        return 1;
+    }
+
+    CoordinateTimeline timeline(source);
+    int64_t fromMs = 0;
+    for (int i = 1; i < argc; i++) {
+        if (wcscmp(argv[i], L"--from") == 0 && i + 1 < argc) {
+            fromMs = (int64_t)(_wtof(argv[++i]) * 1000.0);
+        }
+        else if (wcscmp(argv[i], L"--at") == 0 && i + 1 < argc) {
+            int64_t timeMs = (int64_t)(_wtof(argv[++i]) * 1000.0);
+            CoordinateTimeline::Sample sample;
+            if (timeline.PositionAt(timeMs, &sample)) {
+                wprintf(L"at %.3fs: %d, %d, %d (frame %.3fs)\n", timeMs / 1000.0,
+                    sample.position.x, sample.position.y, sample.position.z, sample.timeMs / 1000.0);
+            }
+            else {
+                wprintf(L"at %.3fs: no coordinates visible\n", timeMs / 1000.0);
+            }
+        }
+        else if (wcscmp(argv[i], L"--near") == 0 && i + 3 < argc) {
+            Vec3 target = { _wtoi(argv[i + 1]), 0, _wtoi(argv[i + 2]) };
+            double radius = _wtof(argv[i + 3]);
+            i += 3;
+            int64_t hitMs;
+            if (timeline.FirstWithin(target, radius, fromMs, &hitMs)) {
+                wprintf(L"within %.0f blocks of %d, %d at %.3fs\n", radius, target.x, target.z, hitMs / 1000.0);
+            }
+            else {
+                wprintf(L"never within %.0f blocks of %d, %d\n", radius, target.x, target.z);
+            }
+        }
+    }
+
+    wprintf(L"decoded %lld of %lld frames\n", (long long)timeline.DecodedFrames(), (long long)timeline.TotalFrames());
+    return 0;
+}
+
+int RunVodQuery(int argc, wchar_t** argv) {
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        FILE* stream;
+        _wfreopen_s(&stream, L"CONOUT$", L"w", stdout);
+    }
+
+    // The Media Foundation source reader needs COM; the source and timeline
+    // are released inside RunVodQueries, before COM goes away.
+    HRESULT com = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    int result = RunVodQueries(argc, argv);
+    if (SUCCEEDED(com)) CoUninitialize();
+    return result;
+}
+
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
+    int argc = 0;
+    wchar_t** argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    if (argv) {
+        for (int i = 1; i < argc; i++) {
+            if (wcscmp(argv[i], L"--vod") == 0) {
+                int result = RunVodQuery(argc, argv);
+                LocalFree(argv);
+                return result;
+            }
+        }
+        LocalFree(argv);
+    }
+
     ChunkCoordinateFinder finder(hInstance);
     finder.Run();
     return 0;
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "WindowRegistry.h"
+
+#include <windows.h>
+
+// Resolves the game window once and keeps the HWND until a WinEvent says it
+// was destroyed, renamed or resized. While no game window exists the miss is
+// cached as well, until some top-level window is shown or renamed. Hooks are
+// out-of-context, so events arrive through the owning thread's message loop.
+class Win32WindowRegistry {
+public:
+    explicit Win32WindowRegistry(const WindowPatterns& patterns = WindowPatterns::Defaults())
+        : patterns(patterns) {
+        instance = this;
+    }
+
+    ~Win32WindowRegistry() {
+        Unhook();
+        if (instance == this) instance = nullptr;
+    }
+
+    void SetPatterns(const WindowPatterns& newPatterns) {
+        patterns = newPatterns;
+        Invalidate();
+    }
+
+    void SetTrace(WindowLookupTrace lookupTrace) {
+        trace = lookupTrace;
+    }
+
+    HWND Resolve() {
+        stats.resolves++;
+        if (state == State::Found && IsWindow(window)) return window;
+        if (state == State::Missing) return nullptr;
+
+        LARGE_INTEGER frequency, start, end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+
+        window = nullptr;
+        EnumWindows(MatchWindow, reinterpret_cast<LPARAM>(this));
+
+        QueryPerformanceCounter(&end);
+        double us = (end.QuadPart - start.QuadPart) * 1e6 / frequency.QuadPart;
+        stats.RecordLookup(us);
+        if (trace) trace(us, window != nullptr);
+
+        Unhook();
+        if (window) {
+            state = State::Found;
+            GetClientRect(window, &clientRect);
+            DWORD processId = 0;
+            GetWindowThreadProcessId(window, &processId);
+            // DESTROY..NAMECHANGE also covers LOCATIONCHANGE; only the game's process
+            hooks[0] = SetWinEventHook(EVENT_OBJECT_DESTROY, EVENT_OBJECT_NAMECHANGE, nullptr,
+                OnWinEvent, processId, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        }
+        else {
+            state = State::Missing;
+            hooks[0] = SetWinEventHook(EVENT_OBJECT_SHOW, EVENT_OBJECT_SHOW, nullptr,
+                OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+            hooks[1] = SetWinEventHook(EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, nullptr,
+                OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        }
+        return window;
+    }
+
+    void Invalidate() {
+        Unhook();
+        state = State::Unknown;
+        window = nullptr;
+    }
+
+    const WindowLookupStats& Stats() const { return stats; }
+
+private:
+    enum class State { Unknown, Found, Missing };
+
+    static BOOL CALLBACK MatchWindow(HWND hwnd, LPARAM lParam) {
+        auto* self = reinterpret_cast<Win32WindowRegistry*>(lParam);
+        char className[256] = "";
+        char title[256] = "";
+        GetClassNameA(hwnd, className, sizeof(className));
+        GetWindowTextA(hwnd, title, sizeof(title));
+        if (self->patterns.Matches(className, title)) {
+            self->window = hwnd;
+            return FALSE;   // stop enumerating
+        }
+        return TRUE;
+    }
+
+    static void CALLBACK OnWinEvent(HWINEVENTHOOK, DWORD event, HWND hwnd, LONG idObject, LONG idChild,
+        DWORD, DWORD) {
+        if (!instance || idObject != OBJID_WINDOW || idChild != CHILDID_SELF || !hwnd) return;
+
+        bool stale = false;
+        if (instance->state == State::Found && hwnd == instance->window) {
+            if (event == EVENT_OBJECT_DESTROY || event == EVENT_OBJECT_NAMECHANGE) {
+                stale = true;
+            }
+            else if (event == EVENT_OBJECT_LOCATIONCHANGE) {
+                // Moves are harmless, only a new size matters
+                RECT rect;
+                stale = !GetClientRect(hwnd, &rect) || rect.right != instance->clientRect.right ||
+                    rect.bottom != instance->clientRect.bottom;
+            }
+        }
+        else if (instance->state == State::Missing) {
+            stale = GetAncestor(hwnd, GA_ROOT) == hwnd;   // a new or renamed top-level window
+        }
+
+        if (stale) {
+            instance->stats.invalidations++;
+            instance->Invalidate();
+        }
+    }
+
+    void Unhook() {
+        for (auto& hook : hooks) {
+            if (hook) UnhookWinEvent(hook);
+            hook = nullptr;
+        }
+    }
+
+    static Win32WindowRegistry* instance;
+
+    WindowPatterns patterns;
+    WindowLookupTrace trace;
+    WindowLookupStats stats;
+    State state = State::Unknown;
+    HWND window = nullptr;
+    RECT clientRect = { 0, 0, 0, 0 };
+    HWINEVENTHOOK hooks[2] = { nullptr, nullptr };
+};
+
+// WinEvent callbacks carry no user pointer; there is one registry per process.
+__declspec(selectany) Win32WindowRegistry* Win32WindowRegistry::instance = nullptr;
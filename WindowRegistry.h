@@ -0,0 +1,132 @@
+#pragma once
+
+// Platform-independent parts of the game window registry: which windows
+// count as the game, and what lookups cost. Win32WindowRegistry.h and
+// X11WindowRegistry.h keep the resolved window cached until the platform
+// reports it destroyed, renamed or resized.
+
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// One rule as written in the config: a class list and a title list, each
+// ';'-separated globs.
+struct WindowRuleText {
+    const char* classes;
+    const char* titles;
+};
+
+// LWJGL 2 (1.8 - 1.12) is the only user of its class, whatever the title.
+// Other programs use GLFW too, so GLFW (1.13+) windows also need "Minecraft"
+// in the title, which launchers such as Fabric or MultiMC keep when they
+// decorate it. Anything titled exactly "Minecraft" counts as well.
+const WindowRuleText kDefaultWindowRules[] = {
+    { "LWJGL", "" },
+    { "GLFW30", "*Minecraft*" },
+    { "", "Minecraft" },
+};
+
+// Case-insensitive glob match supporting '*' and '?'.
+inline bool WildcardMatch(const char* pattern, const char* text) {
+    const char* star = nullptr;
+    const char* resume = nullptr;
+    while (*text) {
+        if (*pattern == '*') {
+            star = pattern++;
+            resume = text;
+        }
+        else if (*pattern == '?' || tolower((unsigned char)*pattern) == tolower((unsigned char)*text)) {
+            pattern++;
+            text++;
+        }
+        else if (star) {
+            pattern = star + 1;
+            text = ++resume;
+        }
+        else {
+            return false;
+        }
+    }
+    while (*pattern == '*') pattern++;
+    return *pattern == '\0';
+}
+
+// Rules of class and title patterns. A window is the game if, for any one
+// rule, its class matches one of the rule's class patterns and its title one
+// of its title patterns; an empty list matches anything.
+struct WindowPatterns {
+    struct Rule {
+        std::vector<std::string> classes;
+        std::vector<std::string> titles;
+    };
+    std::vector<Rule> rules;
+
+    static WindowPatterns Defaults() {
+        WindowPatterns patterns;
+        for (const WindowRuleText& rule : kDefaultWindowRules) patterns.Add(rule.classes, rule.titles);
+        return patterns;
+    }
+
+    static WindowPatterns Parse(const std::string& classList, const std::string& titleList) {
+        WindowPatterns patterns;
+        patterns.Add(classList, titleList);
+        return patterns;
+    }
+
+    void Add(const std::string& classList, const std::string& titleList) {
+        rules.push_back({ Split(classList), Split(titleList) });
+    }
+
+    bool Matches(const char* windowClass, const char* title) const {
+        for (const Rule& rule : rules) {
+            if (MatchesAny(rule.classes, windowClass) && MatchesAny(rule.titles, title)) return true;
+        }
+        return false;
+    }
+
+private:
+    static std::vector<std::string> Split(const std::string& list) {
+        std::vector<std::string> parts;
+        size_t start = 0;
+        while (start <= list.size()) {
+            size_t end = list.find(';', start);
+            if (end == std::string::npos) end = list.size();
+            if (end > start) parts.push_back(list.substr(start, end - start));
+            start = end + 1;
+        }
+        return parts;
+    }
+
+    static bool MatchesAny(const std::vector<std::string>& patterns, const char* text) {
+        if (patterns.empty()) return true;
+        for (const auto& pattern : patterns) {
+            if (WildcardMatch(pattern.c_str(), text ? text : "")) return true;
+        }
+        return false;
+    }
+};
+
+// Counters for comparing cached resolution with a lookup on every read.
+struct WindowLookupStats {
+    uint64_t resolves = 0;       // Resolve() calls
+    uint64_t lookups = 0;        // full window enumerations among them
+    uint64_t invalidations = 0;  // cache drops caused by window events
+    double totalLookupUs = 0.0;
+    double lastLookupUs = 0.0;
+
+    void RecordLookup(double us) {
+        lookups++;
+        totalLookupUs += us;
+        lastLookupUs = us;
+    }
+
+    double AverageLookupUs() const {
+        return lookups ? totalLookupUs / lookups : 0.0;
+    }
+};
+
+// Called after every full enumeration with its cost and whether the game
+// window was found; hook it up to whatever tracing the host has.
+using WindowLookupTrace = std::function<void(double lookupUs, bool found)>;
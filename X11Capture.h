@@ -0,0 +1,168 @@
+#pragma once
+
+// X11 counterpart of BitmapFromHWND, used by the Linux tools
+// (bench/LatencyHarness.cpp). Window lookup lives in X11WindowRegistry.h.
+
+#include "CoordinateDecoder.h"
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+enum class CaptureBackend {
+    WindowGetImage,   // XGetImage on the game window, like PrintWindow
+    RootGetImage,     // XGetImage of the window's area on the root, like a screen BitBlt
+    Shm,              // XShmGetImage into a shared segment reused between captures
+    Count
+};
+
+inline const char* CaptureBackendName(CaptureBackend backend) {
+    switch (backend) {
+    case CaptureBackend::WindowGetImage: return "window-getimage";
+    case CaptureBackend::RootGetImage: return "root-getimage";
+    case CaptureBackend::Shm: return "shm";
+    default: return "unknown";
+    }
+}
+
+// Grabs a window into a PixelView. The view stays valid until the next
+// Capture call or until the capturer is destroyed.
+class X11Capturer {
+public:
+    X11Capturer(Display* display, CaptureBackend backend) : display(display), backend(backend) {}
+
+    ~X11Capturer() {
+        Release();
+    }
+
+    // MIT-SHM needs the extension and a server on this machine that can map
+    // our segments, so try attaching a scratch one; the others work anywhere.
+    static bool Supported(Display* display, CaptureBackend backend) {
+        if (backend != CaptureBackend::Shm) return true;
+        if (!XShmQueryExtension(display)) return false;
+
+        XShmSegmentInfo probe = {};
+        probe.shmid = shmget(IPC_PRIVATE, 4096, IPC_CREAT | 0600);
+        if (probe.shmid < 0) return false;
+        void* address = shmat(probe.shmid, nullptr, 0);
+        bool attached = false;
+        if (address != reinterpret_cast<void*>(-1)) {
+            probe.shmaddr = static_cast<char*>(address);
+            probe.readOnly = False;
+            attached = TrapErrors(display, [&] { return XShmAttach(display, &probe); });
+            if (attached) XShmDetach(display, &probe);
+            XSync(display, False);
+            shmdt(address);
+        }
+        shmctl(probe.shmid, IPC_RMID, nullptr);
+        return attached;
+    }
+
+    bool Capture(Window window, PixelView* view) {
+        XWindowAttributes attributes;
+        if (!XGetWindowAttributes(display, window, &attributes)) return false;
+        int width = attributes.width;
+        int height = attributes.height;
+        if (width <= 0 || height <= 0) return false;
+
+        if (backend == CaptureBackend::Shm) {
+            if (!EnsureShmImage(attributes.visual, attributes.depth, width, height)) return false;
+            // A window unmapped or resized since the attributes were read fails with
+            // BadMatch, which the default handler would turn into exit()
+            if (!TrapErrors(display, [&] { return XShmGetImage(display, window, image, 0, 0, AllPlanes); })) {
+                return false;
+            }
+        }
+        else {
+            if (image) XDestroyImage(image);
+            if (backend == CaptureBackend::RootGetImage) {
+                Window child;
+                int rootX = 0, rootY = 0;
+                XTranslateCoordinates(display, window, attributes.root, 0, 0, &rootX, &rootY, &child);
+                image = XGetImage(display, attributes.root, rootX, rootY, width, height, AllPlanes, ZPixmap);
+            }
+            else {
+                image = XGetImage(display, window, 0, 0, width, height, AllPlanes, ZPixmap);
+            }
+            if (!image) return false;
+        }
+
+        if (image->bits_per_pixel != 32) return false;
+        view->base = reinterpret_cast<const uint8_t*>(image->data);
+        view->rowStride = image->bytes_per_line;
+        view->pixelStride = 4;
+        view->width = image->width;
+        view->height = image->height;
+        view->colorMask = 0x00FFFFFF;   // depth 24 leaves the top byte undefined
+        return true;
+    }
+
+private:
+    static bool& TrappedError() {
+        static bool trapped = false;
+        return trapped;
+    }
+
+    static int TrapError(Display*, XErrorEvent*) {
+        TrappedError() = true;
+        return 0;
+    }
+
+    // Runs `request` and syncs; false if it returned false or the server
+    // answered with an error.
+    template <class Request>
+    static bool TrapErrors(Display* display, Request request) {
+        XErrorHandler previous = XSetErrorHandler(TrapError);
+        TrappedError() = false;
+        bool ok = request();
+        XSync(display, False);
+        ok = ok && !TrappedError();
+        XSetErrorHandler(previous);
+        return ok;
+    }
+
+    bool EnsureShmImage(Visual* visual, int depth, int width, int height) {
+        if (image && image->width == width && image->height == height) return true;
+        Release();
+        if (!XShmQueryExtension(display)) return false;
+
+        image = XShmCreateImage(display, visual, depth, ZPixmap, nullptr, &shmInfo, width, height);
+        if (!image) return false;
+        shmInfo.shmid = shmget(IPC_PRIVATE, image->bytes_per_line * image->height, IPC_CREAT | 0600);
+        if (shmInfo.shmid < 0) { Release(); return false; }
+        void* address = shmat(shmInfo.shmid, nullptr, 0);
+        if (address == reinterpret_cast<void*>(-1)) {
+            shmctl(shmInfo.shmid, IPC_RMID, nullptr);
+            Release();
+            return false;
+        }
+        shmInfo.shmaddr = image->data = static_cast<char*>(address);
+        shmInfo.readOnly = False;
+        // The server refuses segments it cannot map (BadAccess); trap that
+        // instead of letting the default handler exit
+        shmAttached = TrapErrors(display, [&] { return XShmAttach(display, &shmInfo); });
+        shmctl(shmInfo.shmid, IPC_RMID, nullptr);   // freed once both sides detach
+        if (!shmAttached) Release();
+        return shmAttached;
+    }
+
+    void Release() {
+        if (!image) return;
+        if (backend == CaptureBackend::Shm) {
+            if (shmAttached) XShmDetach(display, &shmInfo);
+            if (image->data) shmdt(image->data);
+            image->data = nullptr;
+            shmAttached = false;
+        }
+        XDestroyImage(image);
+        image = nullptr;
+    }
+
+    Display* display;
+    CaptureBackend backend;
+    XImage* image = nullptr;
+    XShmSegmentInfo shmInfo = {};
+    bool shmAttached = false;
+};
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "WindowRegistry.h"
+
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <chrono>
+
+// X11 version of Win32WindowRegistry. The resolved window is watched with
+// StructureNotify and PropertyChange events, so destroy, rename (WM_NAME,
+// _NET_WM_NAME, WM_CLASS) and resize drop the cache; while the game is
+// missing, windows being mapped or the WM's client list changing do; the
+// root is only watched while missing.
+//
+// Events arrive on the registry's Display. If the registry owns that
+// connection, Resolve() drains them itself; otherwise forward them through
+// HandleEvent() and construct with ownsEvents = false.
+class X11WindowRegistry {
+public:
+    explicit X11WindowRegistry(Display* display, const WindowPatterns& patterns = WindowPatterns::Defaults(),
+        bool ownsEvents = true)
+        : display(display), patterns(patterns), ownsEvents(ownsEvents) {
+        root = DefaultRootWindow(display);
+        wmName = XInternAtom(display, "WM_NAME", False);
+        netWmName = XInternAtom(display, "_NET_WM_NAME", False);
+        utf8String = XInternAtom(display, "UTF8_STRING", False);
+        netClientList = XInternAtom(display, "_NET_CLIENT_LIST", False);
+    }
+
+    void SetPatterns(const WindowPatterns& newPatterns) {
+        patterns = newPatterns;
+        Invalidate();
+    }
+
+    void SetTrace(WindowLookupTrace lookupTrace) {
+        trace = lookupTrace;
+    }
+
+    Window Resolve() {
+        stats.resolves++;
+        if (ownsEvents) {
+            while (XPending(display)) {
+                XEvent event;
+                XNextEvent(display, &event);
+                HandleEvent(event);
+            }
+        }
+        if (state == State::Found) return window;
+        if (state == State::Missing) return 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Windows can vanish mid-walk; ignore the resulting BadWindow errors
+        XSync(display, False);
+        XErrorHandler previous = XSetErrorHandler(IgnoreErrors);
+        window = FindIn(root);
+        if (window) {
+            XSelectInput(display, window, StructureNotifyMask | PropertyChangeMask);
+            XSelectInput(display, root, NoEventMask);   // stop hearing about every other window
+            XWindowAttributes attributes;
+            if (XGetWindowAttributes(display, window, &attributes)) {
+                width = attributes.width;
+                height = attributes.height;
+            }
+            else {
+                window = 0;
+            }
+        }
+        else {
+            XSelectInput(display, root, SubstructureNotifyMask | PropertyChangeMask);
+        }
+        XSync(display, False);
+        XSetErrorHandler(previous);
+
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        stats.RecordLookup(us);
+        if (trace) trace(us, window != 0);
+
+        state = window ? State::Found : State::Missing;
+        return window;
+    }
+
+    // Returns true if the event dropped the cache.
+    bool HandleEvent(const XEvent& event) {
+        bool stale = false;
+        if (state == State::Found) {
+            switch (event.type) {
+            case DestroyNotify:
+                stale = event.xdestroywindow.window == window;
+                break;
+            case PropertyNotify:
+                stale = event.xproperty.window == window &&
+                    (event.xproperty.atom == wmName || event.xproperty.atom == netWmName ||
+                        event.xproperty.atom == XA_WM_CLASS);
+                break;
+            case ConfigureNotify:
+                stale = event.xconfigure.window == window &&
+                    (event.xconfigure.width != width || event.xconfigure.height != height);
+                break;
+            }
+        }
+        else if (state == State::Missing) {
+            stale = event.type == MapNotify || event.type == ReparentNotify ||
+                (event.type == PropertyNotify && event.xproperty.window == root && event.xproperty.atom == netClientList);
+        }
+
+        if (stale) {
+            stats.invalidations++;
+            Invalidate();
+        }
+        return stale;
+    }
+
+    void Invalidate() {
+        state = State::Unknown;
+        window = 0;
+    }
+
+    const WindowLookupStats& Stats() const { return stats; }
+
+private:
+    enum class State { Unknown, Found, Missing };
+
+    static int IgnoreErrors(Display*, XErrorEvent*) {
+        return 0;
+    }
+
+    // Window managers reparent clients into frames, so match every level.
+    Window FindIn(Window parent) {
+        Window rootReturn, parentReturn, *children = nullptr;
+        unsigned int count = 0;
+        if (!XQueryTree(display, parent, &rootReturn, &parentReturn, &children, &count)) return 0;
+
+        Window found = 0;
+        for (unsigned int i = 0; i < count && !found; i++) {
+            if (Matches(children[i])) found = children[i];
+        }
+        for (unsigned int i = 0; i < count && !found; i++) {
+            found = FindIn(children[i]);
+        }
+        if (children) XFree(children);
+        return found;
+    }
+
+    bool Matches(Window candidate) {
+        XClassHint hint = { nullptr, nullptr };
+        if (!XGetClassHint(display, candidate, &hint)) return false;
+        std::string windowClass = hint.res_class ? hint.res_class : "";
+        XFree(hint.res_name);
+        XFree(hint.res_class);
+
+        std::string title = Title(candidate);
+        return patterns.Matches(windowClass.c_str(), title.c_str());
+    }
+
+    std::string Title(Window candidate) {
+        std::string title;
+        Atom type;
+        int format;
+        unsigned long count, remaining;
+        unsigned char* data = nullptr;
+        if (XGetWindowProperty(display, candidate, netWmName, 0, 1024, False, utf8String,
+            &type, &format, &count, &remaining, &data) == Success && data) {
+            title.assign(reinterpret_cast<char*>(data), count);
+            XFree(data);
+            if (!title.empty()) return title;
+        }
+
+        char* name = nullptr;
+        if (XFetchName(display, candidate, &name) && name) {
+            title = name;
+            XFree(name);
+        }
+        return title;
+    }
+
+    Display* display;
+    WindowPatterns patterns;
+    bool ownsEvents;
+    WindowLookupTrace trace;
+    WindowLookupStats stats;
+    Window root;
+    Atom wmName, netWmName, utf8String, netClientList;
+    State state = State::Unknown;
+    Window window = 0;
+    int width = 0, height = 0;
+};
@@ -0,0 +1,362 @@
+// End-to-end latency harness: a stand-in "Minecraft" window draws F3
+// coordinates at scripted times while a reader runs the real lookup,
+// capture, decode and publish path against it. Reports, per capture backend
+// and mode, how long after a coordinate was drawn it got published, and the
+// CPU time the reader spent per minute and what finding the window cost.
+//
+// Needs an X server; run_latency_xvfb.sh starts a private Xvfb and builds it.
+//
+//   latency_harness [--backend all|window-getimage|root-getimage|shm]
+//                   [--mode all|hotkey|poll|adaptive] [--samples N] [--interval-ms MS]
+//                   [--poll-hz HZ]
+
+#include "../CoordinateDecoder.h"
+#include "../CpuMeter.h"
+#include "../PollScheduler.h"
+#include "../X11Capture.h"
+#include "../X11WindowRegistry.h"
+#include "SyntheticF3.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+enum class Mode {
+    Hotkey,   // one read right after each draw, as if the hotkey was pressed then
+    Poll,     // fixed-rate capture loop
+    Adaptive, // capture loop paced by PollScheduler
+    Count
+};
+
+static const char* ModeName(Mode mode) {
+    switch (mode) {
+    case Mode::Hotkey: return "hotkey";
+    case Mode::Poll: return "poll";
+    case Mode::Adaptive: return "adaptive";
+    default: return "unknown";
+    }
+}
+
+struct Options {
+    int backend = -1;          // -1 = all
+    int mode = -1;
+    int samples = 300;
+    int intervalMs = 200;
+    double pollHz = 20.0;
+};
+
+struct Event {
+    Vec3 coordinates;
+    Clock::time_point at;
+};
+
+// What the overlay would show: the latest decoded coordinates, plus a log of
+// every publication for the latency match-up afterwards.
+class Publisher {
+public:
+    void Publish(const Vec3& coordinates) {
+        lock_guard<mutex> lock(guard);
+        if (hasLast && coordinates.x == last.x && coordinates.y == last.y && coordinates.z == last.z) return;
+        last = coordinates;
+        hasLast = true;
+        log.push_back({ coordinates, Clock::now() });
+    }
+
+    vector<Event> Log() {
+        lock_guard<mutex> lock(guard);
+        return log;
+    }
+
+private:
+    mutex guard;
+    Vec3 last = { 0, 0, 0 };
+    bool hasLast = false;
+    vector<Event> log;
+};
+
+// Hands "hotkey presses" from the game thread to the reader.
+class Trigger {
+public:
+    void Fire() {
+        lock_guard<mutex> lock(guard);
+        pending++;
+        signal.notify_one();
+    }
+
+    bool Wait(const atomic<bool>& stop) {
+        unique_lock<mutex> lock(guard);
+        signal.wait(lock, [&] { return pending > 0 || stop; });
+        if (pending == 0) return false;
+        pending--;
+        return true;
+    }
+
+    void Wake() {
+        lock_guard<mutex> lock(guard);
+        signal.notify_all();
+    }
+
+private:
+    mutex guard;
+    condition_variable signal;
+    int pending = 0;
+};
+
+static const int kWindowWidth = 854;    // default game window size
+static const int kWindowHeight = 480;
+
+class FakeGameWindow {
+public:
+    bool Open() {
+        display = XOpenDisplay(nullptr);
+        if (!display) return false;
+
+        int screen = DefaultScreen(display);
+        window = XCreateSimpleWindow(display, RootWindow(display, screen), 0, 0,
+            kWindowWidth, kWindowHeight, 0, 0, BlackPixel(display, screen));
+
+        XClassHint hint;
+        hint.res_name = const_cast<char*>("minecraft");
+        hint.res_class = const_cast<char*>("LWJGL");
+        XSetClassHint(display, window, &hint);
+        XStoreName(display, window, "Minecraft");
+        XSelectInput(display, window, StructureNotifyMask);
+        XMapWindow(display, window);
+
+        XEvent event;
+        do { XNextEvent(display, &event); } while (event.type != MapNotify);
+
+        gc = XCreateGC(display, window, 0, nullptr);
+        pixels.assign(kWindowWidth * kWindowHeight, 0);
+        image = XCreateImage(display, DefaultVisual(display, screen), DefaultDepth(display, screen), ZPixmap, 0,
+            reinterpret_cast<char*>(pixels.data()), kWindowWidth, kWindowHeight, 32, kWindowWidth * 4);
+        return image != nullptr;
+    }
+
+    ~FakeGameWindow() {
+        if (image) {
+            image->data = nullptr;   // owned by `pixels`
+            XDestroyImage(image);
+        }
+        if (display) {
+            if (gc) XFreeGC(display, gc);
+            if (window) XDestroyWindow(display, window);
+            XCloseDisplay(display);
+        }
+    }
+
+    // Draws the coordinates and returns once the server has them. The time
+    // returned is when the upload started: Xlib sends a large image in
+    // strips, and a capture can see the text before the last strip lands.
+    Clock::time_point Draw(const Vec3& coordinates) {
+        fill(pixels.begin(), pixels.end(), 0xFF202020);
+        synthetic::RenderCoordinates<LayoutModern>(pixels.data(), kWindowWidth, kWindowWidth, kWindowHeight,
+            coordinates, 2, LayoutModern::leftMargin + 4, LayoutModern::firstRow + 6);
+        Clock::time_point drawn = Clock::now();
+        XPutImage(display, window, gc, image, 0, 0, 0, 0, kWindowWidth, kWindowHeight);
+        XSync(display, False);
+        return drawn;
+    }
+
+private:
+    Display* display = nullptr;
+    Window window = 0;
+    GC gc = nullptr;
+    XImage* image = nullptr;
+    vector<uint32_t> pixels;
+};
+
+// The reader side, mirroring updateCoordinates: find the window, capture
+// it, decode and publish.
+class Reader {
+public:
+    Reader(Display* display, CaptureBackend backend, Publisher& publisher)
+        : capturer(display, backend), windows(display), publisher(publisher) {}
+
+    void Update() {
+        Read();
+        cpuMeter.Sample();
+    }
+
+    double NextIntervalMs() const {
+        return scheduler.NextIntervalMs(true);
+    }
+
+    double CpuMsPerMinute() const {
+        return cpuMeter.CpuMsPerMinute();
+    }
+
+    const WindowLookupStats& LookupStats() const {
+        return windows.Stats();
+    }
+
+private:
+    void Read() {
+        double nowMs = chrono::duration<double, milli>(Clock::now().time_since_epoch()).count();
+        uint64_t lookups = windows.Stats().lookups;
+        Window window = windows.Resolve();
+        if (lastWindow && windows.Stats().lookups != lookups) layouts.Forget(lastWindow);
+        lastWindow = window;
+        PixelView view;
+        Vec3 coordinates;
+        if (window && capturer.Capture(window, &view)
+            && layouts.Decode(window, CropToSearchRegion(view), &coordinates)) {
+            publisher.Publish(coordinates);
+            scheduler.OnReading(coordinates, CalculateNearest4x4Coordinate(coordinates), nowMs);
+        }
+        else {
+            scheduler.OnNoReading();
+        }
+    }
+
+    X11Capturer capturer;
+    X11WindowRegistry windows;
+    Window lastWindow = 0;
+    LayoutCache layouts;
+    PollScheduler scheduler;
+    CpuMeter cpuMeter;
+    Publisher& publisher;
+};
+
+static double Percentile(vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+static bool RunOne(const Options& options, CaptureBackend backend, Mode mode) {
+    FakeGameWindow game;
+    if (!game.Open()) {
+        fprintf(stderr, "cannot open the fake game window (is DISPLAY set?)\n");
+        return false;
+    }
+
+    Display* readerDisplay = XOpenDisplay(nullptr);
+    if (!readerDisplay) return false;
+
+    Publisher publisher;
+    Trigger trigger;
+    atomic<bool> stop(false);
+    double cpuMsPerMinute = 0.0;
+    WindowLookupStats lookupStats;
+
+    thread reader([&] {
+        Reader pipeline(readerDisplay, backend, publisher);
+        if (mode == Mode::Hotkey) {
+            while (trigger.Wait(stop)) pipeline.Update();
+        }
+        else {
+            auto next = Clock::now();
+            while (!stop) {
+                pipeline.Update();
+                double intervalMs = mode == Mode::Poll ? 1000.0 / options.pollHz : pipeline.NextIntervalMs();
+                next += chrono::duration_cast<Clock::duration>(chrono::duration<double, milli>(intervalMs));
+                // Sleep in short slices so the run ends promptly after a long idle interval
+                while (!stop && Clock::now() < next) {
+                    this_thread::sleep_until(min(next, Clock::now() + chrono::milliseconds(100)));
+                }
+            }
+        }
+        cpuMsPerMinute = pipeline.CpuMsPerMinute();
+        lookupStats = pipeline.LookupStats();
+    });
+
+    // Script: walk one block per interval, then stand still for the second
+    // half so the polling modes can be compared on idle cost as well.
+    // Only coordinate changes count towards latency.
+    vector<Event> drawn;
+    Vec3 coordinates = { -1200, 70, 340 };
+    auto next = Clock::now();
+    for (int i = 0; i < options.samples; i++) {
+        bool walking = i < options.samples / 2;
+        if (walking && i > 0) {
+            coordinates.x++;
+            if (i % 3 == 0) coordinates.z--;
+        }
+        Clock::time_point at = game.Draw(coordinates);
+        if (walking) drawn.push_back({ coordinates, at });
+        if (mode == Mode::Hotkey) trigger.Fire();
+        next += chrono::milliseconds(options.intervalMs);
+        this_thread::sleep_until(next);
+    }
+
+    stop = true;
+    trigger.Wake();
+    reader.join();
+    XCloseDisplay(readerDisplay);
+
+    vector<Event> published = publisher.Log();
+    vector<double> latencies;
+    size_t cursor = 0;
+    for (const Event& sample : drawn) {
+        for (size_t i = cursor; i < published.size(); i++) {
+            const Vec3& p = published[i].coordinates;
+            if (p.x == sample.coordinates.x && p.y == sample.coordinates.y && p.z == sample.coordinates.z) {
+                latencies.push_back(chrono::duration<double, milli>(published[i].at - sample.at).count());
+                cursor = i + 1;
+                break;
+            }
+        }
+    }
+    sort(latencies.begin(), latencies.end());
+
+    printf("%-16s %-8s published %4zu/%-4zu  p50 %7.2f ms  p90 %7.2f ms  p99 %7.2f ms  max %7.2f ms  cpu %7.1f ms/min  "
+        "lookups %llu/%llu avg %.1f us\n",
+        CaptureBackendName(backend), ModeName(mode), latencies.size(), drawn.size(),
+        Percentile(latencies, 50), Percentile(latencies, 90), Percentile(latencies, 99),
+        latencies.empty() ? 0.0 : latencies.back(), cpuMsPerMinute,
+        (unsigned long long)lookupStats.lookups, (unsigned long long)lookupStats.resolves,
+        lookupStats.AverageLookupUs());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i], value = argv[i + 1];
+        if (flag == "--backend") {
+            for (int b = 0; b < (int)CaptureBackend::Count; b++)
+                if (value == CaptureBackendName((CaptureBackend)b)) options.backend = b;
+        }
+        else if (flag == "--mode") {
+            for (int m = 0; m < (int)Mode::Count; m++)
+                if (value == ModeName((Mode)m)) options.mode = m;
+        }
+        else if (flag == "--samples") options.samples = atoi(value.c_str());
+        else if (flag == "--interval-ms") options.intervalMs = atoi(value.c_str());
+        else if (flag == "--poll-hz") options.pollHz = atof(value.c_str());
+    }
+
+    XInitThreads();
+    Display* probe = XOpenDisplay(nullptr);
+    if (!probe) {
+        fprintf(stderr, "cannot open the display (is DISPLAY set?)\n");
+        return 1;
+    }
+    for (int b = 0; b < (int)CaptureBackend::Count; b++) {
+        if (options.backend >= 0 && options.backend != b) continue;
+        if (!X11Capturer::Supported(probe, (CaptureBackend)b)) {
+            printf("%-16s skipped, not supported by this X server\n", CaptureBackendName((CaptureBackend)b));
+            continue;
+        }
+        for (int m = 0; m < (int)Mode::Count; m++) {
+            if (options.mode >= 0 && options.mode != m) continue;
+            if (!RunOne(options, (CaptureBackend)b, (Mode)m)) {
+                XCloseDisplay(probe);
+                return 1;
+            }
+        }
+    }
+    XCloseDisplay(probe);
+    return 0;
+}
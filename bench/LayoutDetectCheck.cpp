@@ -0,0 +1,71 @@
+// Renders the F3 coordinates with every layout profile at several scales and
+// checks that detection picks that profile and decodes the right values.
+// Any profile another one shadows shows up here as a wrong LayoutId.
+//
+//   g++ -std=c++17 -O2 LayoutDetectCheck.cpp -o layout_detect_check
+//   ./layout_detect_check
+
+#include "SyntheticF3.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+static const char* LayoutName(LayoutId id) {
+    switch (id) {
+    case LayoutId::Modern: return "Modern";
+    case LayoutId::Legacy: return "Legacy";
+    case LayoutId::TextBackground: return "TextBackground";
+    case LayoutId::Unicode: return "Unicode";
+    default: return "?";
+    }
+}
+
+// Large enough that the search region fits the widest text at scale 3.
+static const int kWidth = 2560;
+static const int kHeight = 1440;
+
+template <class Layout>
+static bool CheckProfile(vector<uint32_t>& pixels) {
+    const Vec3 positions[] = { { -1204, 70, 340 }, { 11, -59, -1111 }, { 98765, 320, -4 }, { 0, 0, 0 } };
+    bool ok = true;
+
+    for (int scale = 1; scale <= 3; scale++) {
+        for (const Vec3& position : positions) {
+            fill(pixels.begin(), pixels.end(), 0xFF000000);
+            synthetic::RenderCoordinates<Layout>(pixels.data(), kWidth, kWidth, kHeight,
+                position, scale, Layout::leftMargin + 4, Layout::firstRow + 6);
+
+            PixelView view;
+            view.base = reinterpret_cast<const uint8_t*>(pixels.data());
+            view.rowStride = kWidth * 4;
+            view.width = kWidth;
+            view.height = kHeight;
+
+            LayoutId detected = LayoutId::Count;
+            Vec3 decoded = { 0, 0, 0 };
+            bool found = DetectLayout(CropToSearchRegion(view), &detected, &decoded);
+            bool match = found && detected == Layout::id &&
+                decoded.x == position.x && decoded.y == position.y && decoded.z == position.z;
+            if (!match) {
+                printf("FAIL %-14s scale %d  %d, %d, %d  ->  %s  %d, %d, %d\n", LayoutName(Layout::id), scale,
+                    position.x, position.y, position.z, found ? LayoutName(detected) : "not found",
+                    decoded.x, decoded.y, decoded.z);
+            }
+            ok &= match;
+        }
+    }
+    printf("%-14s %s\n", LayoutName(Layout::id), ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main() {
+    vector<uint32_t> pixels(kWidth * kHeight);
+    bool ok = true;
+    ok &= CheckProfile<LayoutModern>(pixels);
+    ok &= CheckProfile<LayoutLegacy>(pixels);
+    ok &= CheckProfile<LayoutTextBackground>(pixels);
+    ok &= CheckProfile<LayoutUnicode>(pixels);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// Paint cost of the overlay with and without damage tracking, on the
+// headless software surface. Every update is also pixel-diffed against a
+// full redraw of the same text; any difference fails the run.
+//
+//   g++ -std=c++17 -O2 OverlayPaintBench.cpp -o overlay_paint_bench
+//   ./overlay_paint_bench [updates]
+
+#include "../CoordinateDecoder.h"
+#include "../OverlayRenderer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    int updates = argc > 1 ? atoi(argv[1]) : 100000;
+    const int width = 200, height = 80;   // overlay window size
+
+    SoftwareOverlaySurface trackedSurface(width, height);
+    SoftwareOverlaySurface fullSurface(width, height);
+    OverlayRenderer tracked(trackedSurface);
+    OverlayRenderer full(fullSurface);
+
+    double trackedSeconds = 0.0, fullSeconds = 0.0;
+    long long trackedPixels = 0;
+    Vec3 player = { -1187, 70, 342 };
+
+    for (int i = 0; i < updates; i++) {
+        // Walk towards a dig spot, mostly one axis at a time like real movement
+        if (i % 2 == 0) player.x++;
+        if (i % 7 == 0) player.z--;
+        wstring text = FormatReadingText(player, CalculateNearest4x4Coordinate(player), 40 + (i / 500) % 20);
+
+        auto start = Clock::now();
+        const vector<OverlayRect>& dirty = tracked.SetText(text);
+        auto middle = Clock::now();
+        full.InvalidateAll();
+        full.SetText(text);
+        auto end = Clock::now();
+
+        trackedSeconds += chrono::duration<double>(middle - start).count();
+        fullSeconds += chrono::duration<double>(end - middle).count();
+        for (const OverlayRect& r : dirty) trackedPixels += (long long)(r.right - r.left) * (r.bottom - r.top);
+
+        if (trackedSurface.Pixels() != fullSurface.Pixels()) {
+            const vector<uint32_t>& a = trackedSurface.Pixels();
+            const vector<uint32_t>& b = fullSurface.Pixels();
+            size_t at = 0;
+            while (a[at] == b[at]) at++;
+            printf("FAIL: update %d differs from a full redraw at (%zu, %zu)\n", i, at % width, at / width);
+            return 1;
+        }
+    }
+
+    printf("updates            %d\n", updates);
+    printf("damage-tracked     %8.3f us/update  %8.1f px/update\n",
+        trackedSeconds / updates * 1e6, (double)trackedPixels / updates);
+    printf("full redraw        %8.3f us/update  %8d px/update\n", fullSeconds / updates * 1e6, width * height);
+    printf("pixel diff         identical on every update\n");
+    return 0;
+}
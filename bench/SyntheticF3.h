@@ -0,0 +1,57 @@
+#pragma once
+
+// Draws the part of the F3 screen the decoder looks at: the first stroke it
+// measures the GUI scale from, then one column per glyph of the coordinates
+// from the profile's glyph table, on the profile's background box if it has
+// one. The output decodes exactly like the real thing, which is all the
+// benches need; it is not meant to look like Minecraft text.
+
+#include "../CoordinateDecoder.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace synthetic {
+
+// `stride` is in pixels. (originX, originY) is where the text starts and
+// must be at or past Layout::leftMargin / Layout::firstRow.
+template <class Layout>
+void RenderCoordinates(uint32_t* pixels, int stride, int width, int height,
+    const Vec3& coordinates, int scale, int originX, int originY) {
+    auto fill = [&](int x, int y, int w, int h) {
+        for (int py = y; py < y + h && py < height; py++)
+            for (int px = x; px < x + w && px < width; px++)
+                pixels[py * stride + px] = Layout::textColor;
+    };
+
+    const GlyphColumns& glyphs = Layout::Glyphs();
+    int values[3] = { coordinates.x, coordinates.y, coordinates.z };
+
+    if (Layout::hasBackground) {
+        // Wide enough for the longest coordinates, one font pixel of padding
+        int boxWidth = (Layout::prefixWidth + 24 * Layout::glyphAdvance + 2) * scale;
+        int boxHeight = (glyphs.rows + 2) * scale;
+        for (int py = originY - scale; py < originY - scale + boxHeight && py < height; py++)
+            for (int px = originX - scale; px < originX - scale + boxWidth && px < width; px++)
+                pixels[py * stride + px] = Layout::backgroundColor;
+    }
+
+    fill(originX, originY, Layout::streakUnit * scale, 1);
+
+    int x = originX + Layout::prefixWidth * scale;
+    auto column = [&](unsigned int mask, int advance) {
+        for (int dy = 0; dy < glyphs.rows; dy++) {
+            if (mask & (1u << (glyphs.rows - 1 - dy))) fill(x, originY + dy * scale, scale, scale);
+        }
+        x += (advance ? advance : Layout::glyphAdvance) * scale;
+    };
+
+    for (int i = 0; i < 3; i++) {
+        if (values[i] < 0) column(glyphs.minus, 0);
+        for (char c : std::to_string(abs(values[i]))) column(glyphs.digits[c - '0'], glyphs.digitAdvance[c - '0']);
+        if (i < 2) column(glyphs.separator, 0);
+    }
+}
+
+} // namespace synthetic
@@ -0,0 +1,132 @@
+// Checks CoordinateTimeline queries against a scripted recording whose
+// frames are drawn on demand, so no video file is needed. Prints the answer
+// and how many frames it took; a wrong answer fails the run.
+//
+//   g++ -std=c++17 -O2 TimelineQueryCheck.cpp -o timeline_query_check
+//   ./timeline_query_check
+
+#include "../CoordinateTimeline.h"
+#include "SyntheticF3.h"
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+// A recording of `durationMs` at 60 fps where the player is wherever
+// `script` says at each moment. Frames for which `script` returns false show
+// no F3 text, like a menu or the pause screen.
+class ScriptedSource : public FrameSource {
+public:
+    using Script = function<bool(int64_t timeMs, Vec3* position)>;
+
+    ScriptedSource(int64_t durationMs, Script script)
+        : durationMs(durationMs), script(script), pixels(kWidth * kHeight) {}
+
+    int64_t DurationMs() const override { return durationMs; }
+    int64_t FrameIntervalMs() const override { return 16; }
+
+    bool ReadFrameAt(int64_t timeMs, PixelView* view) override {
+        fill(pixels.begin(), pixels.end(), 0xFF000000);
+        Vec3 position;
+        if (script(timeMs, &position)) {
+            synthetic::RenderCoordinates<LayoutModern>(pixels.data(), kWidth, kWidth, kHeight,
+                position, 2, LayoutModern::leftMargin + 4, LayoutModern::firstRow + 6);
+        }
+        view->base = reinterpret_cast<const uint8_t*>(pixels.data());
+        view->rowStride = kWidth * 4;
+        view->pixelStride = 4;
+        view->width = kWidth;
+        view->height = kHeight;
+        return true;
+    }
+
+private:
+    static const int kWidth = 854;
+    static const int kHeight = 480;
+
+    int64_t durationMs;
+    Script script;
+    vector<uint32_t> pixels;
+};
+
+static bool Check(const char* name, int64_t got, int64_t wantMin, int64_t wantMax, int64_t decoded, int64_t total) {
+    bool ok = got >= wantMin && got <= wantMax;
+    printf("%-40s %s  %9.3f s  (%lld/%lld frames decoded)\n", name, ok ? "ok  " : "FAIL", got / 1000.0,
+        (long long)decoded, (long long)total);
+    return ok;
+}
+
+static bool CheckSample(const char* name, bool found, const CoordinateTimeline::Sample& got,
+    int64_t wantMs, int wantX, int64_t wantDecoded, int64_t decoded) {
+    bool ok = found == (wantMs >= 0) && decoded == wantDecoded &&
+        (!found || (got.timeMs == wantMs && got.position.x == wantX));
+    if (found) {
+        printf("%-40s %s  %9.3f s  x %d  (%lld frames decoded)\n", name, ok ? "ok  " : "FAIL", got.timeMs / 1000.0,
+            got.position.x, (long long)decoded);
+    }
+    else {
+        printf("%-40s %s  not found    (%lld frames decoded)\n", name, ok ? "ok  " : "FAIL", (long long)decoded);
+    }
+    return ok;
+}
+
+int main() {
+    const Vec3 target = { 1204, 70, -340 };
+    bool ok = true;
+
+    // Stands 60 blocks out, dips to 40 blocks from 317 s to 327 s, comes
+    // back for good at 900 s. The first visit is the answer.
+    {
+        ScriptedSource source(1200 * 1000, [&](int64_t t, Vec3* position) {
+            int distance = (t >= 317000 && t < 327000) ? 40 : t >= 900000 ? 10 : 60;
+            *position = { target.x - distance, target.y, target.z };
+            return true;
+        });
+        CoordinateTimeline timeline(source);
+        int64_t hitMs = -1;
+        timeline.FirstWithin(target, 50.0, 0, &hitMs);
+        ok &= Check("short visit before a long wait", hitMs, 316990, 317010,
+            timeline.DecodedFrames(), timeline.TotalFrames());
+    }
+
+    // Walks in at 5 blocks per second from 200 blocks out.
+    {
+        ScriptedSource source(120 * 1000, [&](int64_t t, Vec3* position) {
+            int distance = (std::max)(0, 200 - (int)(t * 5 / 1000));
+            *position = { target.x, target.y, target.z + distance };
+            return true;
+        });
+        CoordinateTimeline timeline(source);
+        int64_t hitMs = -1;
+        timeline.FirstWithin(target, 50.0, 0, &hitMs);
+        ok &= Check("steady approach", hitMs, 29984, 30016, timeline.DecodedFrames(), timeline.TotalFrames());
+    }
+
+    // Walks one block per second with F3 closed from 10 s to 12 s. Asking
+    // for 11 s probes outwards 16, 32, ... 1024 ms, alternating before and
+    // after, and settles on the last readable frame before the gap.
+    ScriptedSource::Script walkWithGap = [](int64_t t, Vec3* position) {
+        *position = { (int)(t / 1000), 64, 0 };
+        return t < 10000 || t >= 12000;
+    };
+    {
+        ScriptedSource source(60 * 1000, walkWithGap);
+        CoordinateTimeline timeline(source);
+        CoordinateTimeline::Sample sample = {};
+        bool found = timeline.PositionAt(11000, &sample);
+        ok &= CheckSample("position inside an unreadable stretch", found, sample, 9968, 9, 14,
+            timeline.DecodedFrames());
+    }
+    {
+        ScriptedSource source(60 * 1000, walkWithGap);
+        CoordinateTimeline timeline(source);
+        CoordinateTimeline::Sample sample = {};
+        bool found = timeline.PositionAt(11000, &sample, 500);
+        ok &= CheckSample("position past the probe tolerance", found, sample, -1, 0, 11,
+            timeline.DecodedFrames());
+    }
+
+    return ok ? 0 : 1;
+}
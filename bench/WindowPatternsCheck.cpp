@@ -0,0 +1,74 @@
+// Checks the default window rules against the windows the game and its
+// launchers open, and against other programs that look similar. Every window
+// the original FindWindow("LWJGL") / FindWindow("Minecraft") lookup found
+// must still match.
+//
+//   g++ -std=c++17 -O2 WindowPatternsCheck.cpp -o window_patterns_check
+//   ./window_patterns_check
+
+#include "../WindowRegistry.h"
+
+#include <cstdio>
+
+struct Case {
+    const char* windowClass;
+    const char* title;
+    bool game;
+};
+
+static bool CheckCases(const char* name, const WindowPatterns& patterns, const Case* cases, int count) {
+    bool ok = true;
+    for (int i = 0; i < count; i++) {
+        bool matched = patterns.Matches(cases[i].windowClass, cases[i].title);
+        if (matched != cases[i].game) {
+            printf("FAIL %-10s \"%s\" / \"%s\"  ->  %s\n", name, cases[i].windowClass, cases[i].title,
+                matched ? "matched" : "not matched");
+            ok = false;
+        }
+    }
+    printf("%-10s %s\n", name, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+
+    const Case defaults[] = {
+        // Found by FindWindow("LWJGL", nullptr): any title
+        { "LWJGL", "Minecraft 1.8.9", true },
+        { "LWJGL", "Minecraft", true },
+        { "LWJGL", "", true },
+        { "LWJGL", "Lunar Client (1.8.9-4f2e1a7/master)", true },
+        // Found by FindWindow(nullptr, "Minecraft"): any class
+        { "SunAwtFrame", "Minecraft", true },
+        { "GLFW30", "Minecraft", true },
+        // GLFW builds, as launchers title them
+        { "GLFW30", "Minecraft* 1.16.1 - Singleplayer", true },
+        { "GLFW30", "Fabric Minecraft 1.16.1", true },
+        { "glfw30", "minecraft 1.20.1", true },
+        // Other programs
+        { "GLFW30", "Blender", false },
+        { "Chrome_WidgetWin_1", "Minecraft Launcher", false },
+        { "MozillaWindowClass", "Minecraft Wiki - Mozilla Firefox", false },
+        { "Notepad", "minecraft.txt - Notepad", false },
+    };
+    ok &= CheckCases("defaults", WindowPatterns::Defaults(), defaults, sizeof(defaults) / sizeof(defaults[0]));
+
+    // One rule from the config: both lists have to match, a blank list matches anything
+    const Case custom[] = {
+        { "GLFW30", "Prism Launcher: 1.16.1", true },
+        { "LWJGL", "Prism Launcher: 1.8.9", false },
+        { "GLFW30", "Minecraft 1.16.1", false },
+    };
+    ok &= CheckCases("custom", WindowPatterns::Parse("GLFW30", "Prism Launcher*"), custom,
+        sizeof(custom) / sizeof(custom[0]));
+
+    const Case anyClass[] = {
+        { "Whatever", "Prism Launcher: 1.16.1", true },
+        { "Whatever", "Minecraft", false },
+    };
+    ok &= CheckCases("any class", WindowPatterns::Parse("", "Prism Launcher*"), anyClass,
+        sizeof(anyClass) / sizeof(anyClass[0]));
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+#!/bin/sh
+# Builds the latency harness and runs it against a private Xvfb display.
+# Extra arguments are passed through, e.g. --backend shm --mode poll.
+set -e
+cd "$(dirname "$0")"
+
+g++ -std=c++17 -O2 -I.. LatencyHarness.cpp -o latency_harness -lX11 -lXext -pthread
+
+DISPLAY_NUM=${DISPLAY_NUM:-99}
+Xvfb ":$DISPLAY_NUM" -screen 0 1280x720x24 -nolisten tcp &
+XVFB_PID=$!
+trap 'kill $XVFB_PID' EXIT
+sleep 1
+
+DISPLAY=":$DISPLAY_NUM" ./latency_harness "$@"
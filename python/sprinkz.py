@@ -0,0 +1,114 @@
+"""Thin Python bindings for the Sprinkz C API (SprinkzApi.h).
+
+Frames are handed to the library in place: anything exposing the buffer
+protocol (NumPy arrays, memoryviews of video decoder output, ...) is viewed
+with numpy.asarray, which does not copy, and its pointer, shape and strides
+are passed straight through. The calls go through ctypes.CDLL, which
+releases the GIL for their duration, so several Python threads can decode
+batches in parallel.
+
+The shared library is looked up in SPRINKZ_LIB, then next to this file.
+"""
+
+import ctypes
+import os
+import sys
+
+import numpy as np
+
+API_VERSION = 1
+
+# Per-channel tolerance suited to frames decoded from lossy video, whose text
+# is never exactly white (SPRINKZ_VIDEO_TOLERANCE).
+VIDEO_TOLERANCE = 31
+
+_c_int64_4 = ctypes.c_int64 * 4
+
+
+class _DecodeOptions(ctypes.Structure):
+    _fields_ = [("size", ctypes.c_uint32), ("tolerance", ctypes.c_int32)]
+
+
+def _load():
+    path = os.environ.get("SPRINKZ_LIB")
+    if not path:
+        name = "sprinkz.dll" if sys.platform == "win32" else "libsprinkz.so"
+        path = os.path.join(os.path.dirname(os.path.abspath(__file__)), name)
+    lib = ctypes.CDLL(path)
+
+    lib.sprinkz_api_version.restype = ctypes.c_int32
+    lib.sprinkz_api_version.argtypes = []
+
+    lib.sprinkz_decode_batch.restype = ctypes.c_int64
+    lib.sprinkz_decode_batch.argtypes = [
+        ctypes.c_void_p, _c_int64_4, _c_int64_4, ctypes.POINTER(_DecodeOptions),
+        ctypes.c_void_p, ctypes.c_void_p]
+
+    lib.sprinkz_nearest_4x4_batch.restype = ctypes.c_int32
+    lib.sprinkz_nearest_4x4_batch.argtypes = [ctypes.c_void_p, ctypes.c_int64, ctypes.c_void_p]
+
+    if lib.sprinkz_api_version() != API_VERSION:
+        raise ImportError("sprinkz library at %s has API version %d, expected %d"
+                          % (path, lib.sprinkz_api_version(), API_VERSION))
+    return lib
+
+
+_lib = _load()
+
+
+def _check_output(array, shape, dtype, name):
+    if array is None:
+        return np.empty(shape, dtype=dtype)
+    if array.shape != shape or array.dtype != dtype or not array.flags.c_contiguous \
+            or not array.flags.writeable:
+        raise ValueError("%s must be a writable C-contiguous %s array of shape %s"
+                         % (name, np.dtype(dtype).name, shape))
+    return array
+
+
+def decode_batch(frames, coords=None, found=None, tolerance=0):
+    """Reads the F3 coordinates shown in each frame.
+
+    frames: uint8 array of shape (N, H, W, C) or (H, W, C) with C = 3 or 4
+    and contiguous channels; any row and pixel strides are accepted.
+    coords / found: optional preallocated int32 (N, 3) and bool (N,) outputs.
+    tolerance: per-channel difference from the text colour still counted as
+    text, 0-255. Keep 0 for screen captures; use VIDEO_TOLERANCE for frames
+    from a video file.
+
+    Returns (coords, found).
+    """
+    frames = np.asarray(frames)
+    if frames.ndim == 3:
+        frames = frames[np.newaxis]
+    if frames.dtype != np.uint8 or frames.ndim != 4:
+        raise ValueError("frames must be a uint8 array of shape (N, H, W, C)")
+
+    count = frames.shape[0]
+    coords = _check_output(coords, (count, 3), np.int32, "coords")
+    found = _check_output(found, (count,), np.bool_, "found")
+
+    options = _DecodeOptions(ctypes.sizeof(_DecodeOptions), tolerance)
+    result = _lib.sprinkz_decode_batch(
+        frames.ctypes.data, _c_int64_4(*frames.shape), _c_int64_4(*frames.strides),
+        ctypes.byref(options), coords.ctypes.data, found.ctypes.data)
+    if result == -1:
+        raise ValueError("sprinkz_decode_batch failed with code -1 "
+                         "(invalid shape, or tolerance outside 0-255)")
+    if result < 0:
+        raise ValueError("sprinkz_decode_batch failed with code %d "
+                         "(channels must be 3 or 4 and contiguous)" % result)
+    return coords, found
+
+
+def nearest_4x4(positions, out=None):
+    """Rounds (N, 3) player positions to the nearest 4x4 dig spots."""
+    positions = np.ascontiguousarray(positions, dtype=np.int32)
+    if positions.ndim == 1:
+        positions = positions[np.newaxis]
+    if positions.ndim != 2 or positions.shape[1] != 3:
+        raise ValueError("positions must have shape (N, 3)")
+
+    out = _check_output(out, positions.shape, np.int32, "out")
+    _lib.sprinkz_nearest_4x4_batch(positions.ctypes.data, positions.shape[0], out.ctypes.data)
+    return out